@@ -0,0 +1,321 @@
+/**
+ * 礼物动画资源（SVGA）磁盘缓存：按 resourceURL 的哈希建索引，总大小受字节预算约束，超出时按最近使用时间淘汰；
+ * 命中后在后台按会话校验一次文件摘要与服务端 ETag，资源变化时重新下载。
+ * 收到可用礼物列表或打开礼物面板时按金币从高到低后台预取，使热门礼物首次播放无需等待下载。
+ * 首次加载索引时清理旧版本按 name-giftID 存在 plus.storage 中的路径与对应文件
+ * @module GiftAssetCache
+ */
+import { downloadGiftAsset, joinDownload, hashURL, recordGiftAssetHit, DownloadPriority } from './giftService'
+
+type CacheEntry = {
+    url: string
+    path: string      // 本地绝对路径，直接交给 svga-player
+    size: number
+    digest: string    // 下载完成时文件的 md5
+    etag: string      // 下载时服务端返回的 ETag，服务端不提供时为空
+    lastUsed: number
+}
+
+type PrefetchGift = {
+    resourceURL?: string
+    coins?: number
+    [k: string]: any
+}
+
+const STORAGE_KEY = 'atomicx_gift_asset_cache'
+const LEGACY_CLEANED_KEY = 'atomicx_gift_legacy_cleaned'
+// 旧版本 GiftPlayer 以 `${name}-${giftID}` 为 key、uni.saveFile 保存的绝对路径为值写入 plus.storage
+const LEGACY_KEY_PATTERN = /^\S*-[^-\s]+$/
+const LEGACY_PATH_PATTERN = /\/uniapp_save\/[^/]+$/
+const DEFAULT_BUDGET_BYTES = 64 * 1024 * 1024
+// 预取只填充到预算的该比例，避免预取之间互相淘汰、挤掉刚播放过的资源
+const PREFETCH_FILL_RATIO = 0.8
+const PREFETCH_CONCURRENCY = 2
+const INDEX_SAVE_DELAY_MS = 1000
+
+let budgetBytes = DEFAULT_BUDGET_BYTES
+let index: Record<string, CacheEntry> | null = null
+let saveTimer: ReturnType<typeof setTimeout> | null = null
+const pending = new Map<string, Promise<string>>()   // key -> 进行中的下载
+const revalidated = new Set<string>()                // 本次会话已校验过的 key
+let prefetchQueue: string[] = []
+let prefetchRunning = 0
+
+function loadIndex(): Record<string, CacheEntry> {
+    if (!index) {
+        cleanLegacyAssets()
+        try {
+            index = (uni.getStorageSync(STORAGE_KEY) as Record<string, CacheEntry>) || {}
+        } catch (error) {
+            console.error('giftAssetCache load index error:', error)
+            index = {}
+        }
+    }
+    return index
+}
+
+/**
+ * 索引合并延迟落盘，连续命中只写一次
+ */
+function scheduleSave(): void {
+    if (saveTimer) return
+    saveTimer = setTimeout(() => {
+        saveTimer = null
+        uni.setStorage({
+            key: STORAGE_KEY,
+            data: loadIndex(),
+            fail: (error) => console.error('giftAssetCache save index error:', error),
+        })
+    }, INDEX_SAVE_DELAY_MS)
+}
+
+function totalBytes(): number {
+    return Object.values(loadIndex()).reduce((sum, entry) => sum + entry.size, 0)
+}
+
+function removeFile(path: string): void {
+    plus.io.resolveLocalFileSystemURL(path, (entry) => entry.remove(), () => { })
+}
+
+/**
+ * 删除旧版本留下的 plus.storage 记录与文件，只执行一次。旧记录没有 resourceURL，无法迁移为索引条目
+ */
+function cleanLegacyAssets(): void {
+    try {
+        if (uni.getStorageSync(LEGACY_CLEANED_KEY) || typeof plus === 'undefined' || !plus.storage) return
+        const keys: string[] = []
+        for (let i = 0; i < plus.storage.getLength(); i++) {
+            const key = plus.storage.key(i)
+            if (key && LEGACY_KEY_PATTERN.test(key)) keys.push(key)
+        }
+        keys.forEach((key) => {
+            const path = plus.storage.getItem(key)
+            if (path && LEGACY_PATH_PATTERN.test(path)) {
+                plus.storage.removeItem(key)
+                removeFile(path)
+            }
+        })
+        uni.setStorageSync(LEGACY_CLEANED_KEY, true)
+    } catch (error) {
+        console.error('giftAssetCache clean legacy assets error:', error)
+    }
+}
+
+function removeEntry(key: string): void {
+    const entry = loadIndex()[key]
+    if (!entry) return
+    delete loadIndex()[key]
+    removeFile(entry.path)
+    scheduleSave()
+}
+
+/**
+ * 按最近使用时间从旧到新淘汰，直到总大小不超过预算；keepKey 为刚写入的条目，不参与淘汰
+ */
+function evict(keepKey?: string): void {
+    const entries = Object.entries(loadIndex())
+        .filter(([key]) => key !== keepKey)
+        .sort((a, b) => a[1].lastUsed - b[1].lastUsed)
+    let total = totalBytes()
+    for (const [key, entry] of entries) {
+        if (total <= budgetBytes) break
+        total -= entry.size
+        removeEntry(key)
+    }
+}
+
+function fileExists(path: string): Promise<boolean> {
+    return new Promise((resolve) => plus.io.resolveLocalFileSystemURL(path, () => resolve(true), () => resolve(false)))
+}
+
+function getFileInfo(path: string): Promise<{ size: number, digest: string }> {
+    return new Promise((resolve, reject) => {
+        uni.getFileInfo({
+            filePath: path,
+            digestAlgorithm: 'md5',
+            success: (res) => resolve({ size: res.size, digest: (res.digest || '').toLowerCase() }),
+            fail: reject,
+        })
+    })
+}
+
+/**
+ * HEAD 请求取服务端 ETag（去掉引号与弱校验前缀），失败或不提供时返回空串。
+ * 用于后台校验，以及下载方式拿不到响应头时补取
+ */
+function fetchETag(url: string): Promise<string> {
+    return new Promise((resolve) => {
+        uni.request({
+            url,
+            method: 'HEAD',
+            success: (res) => {
+                const header = (res.header || {}) as Record<string, string>
+                const etag = header.ETag || header.Etag || header.etag || ''
+                resolve(res.statusCode === 200 ? etag.replace(/^W\//, '').replace(/"/g, '') : '')
+            },
+            fail: () => resolve(''),
+        })
+    })
+}
+
+/**
+ * ETag 为 32 位十六进制时（如对象存储单次上传的文件）即为内容 md5，可直接与本地摘要比较
+ */
+function isContentMD5(etag: string): boolean {
+    return /^[0-9a-f]{32}$/i.test(etag)
+}
+
+/**
+ * 下载并写入缓存，同一 key 的并发请求共用一次下载
+ */
+function download(url: string, key: string, priority: DownloadPriority): Promise<string> {
+    const inflight = pending.get(key)
+    if (inflight) {
+        // 预取中的资源被播放请求时，提前其在下载队列中的位置
+        joinDownload(url, priority)
+        return inflight
+    }
+    const task = downloadGiftAsset(url, priority)
+        .then(async (result) => {
+            const path = result.path
+            const etag = result.etag ?? await fetchETag(url)
+            const { size, digest } = await getFileInfo(path)
+            if (isContentMD5(etag) && etag.toLowerCase() !== digest) {
+                removeFile(path)
+                throw new Error('礼物资源校验失败')
+            }
+            const old = loadIndex()[key]
+            if (old && old.path !== path) {
+                removeFile(old.path)
+            }
+            loadIndex()[key] = { url, path, size, digest, etag, lastUsed: Date.now() }
+            revalidated.add(key)
+            evict(key)
+            scheduleSave()
+            return path
+        })
+        .finally(() => pending.delete(key))
+    pending.set(key, task)
+    return task
+}
+
+/**
+ * 后台校验命中的条目，每个条目每次会话最多一次：文件丢失或摘要不符时删除；
+ * 服务端 ETag 与下载时不同（或与内容 md5 不符）时重新下载，下次播放使用新文件
+ */
+async function revalidate(key: string): Promise<void> {
+    if (revalidated.has(key)) return
+    revalidated.add(key)
+    const entry = loadIndex()[key]
+    if (!entry) return
+    try {
+        const { digest } = await getFileInfo(entry.path)
+        if (digest !== entry.digest) {
+            removeEntry(key)
+            return
+        }
+    } catch (error) {
+        removeEntry(key)
+        return
+    }
+    const etag = await fetchETag(entry.url)
+    if (!etag) return
+    const changed = entry.etag ? etag !== entry.etag : (isContentMD5(etag) && etag.toLowerCase() !== entry.digest)
+    if (changed) {
+        download(entry.url, key, 'low').catch((error) => console.warn('giftAssetCache revalidate download error:', error))
+    }
+}
+
+/**
+ * 同步查询缓存，命中时刷新最近使用时间并在后台校验，未命中返回 null。
+ * 不检查文件是否仍存在（可能被系统清理），播放前应使用 getGiftAsset
+ * @param {string} url - 礼物 resourceURL
+ * @returns {string | null} 本地绝对路径
+ */
+export function getCachedGiftAsset(url: string): string | null {
+    if (!url) return null
+    const key = hashURL(url)
+    const entry = loadIndex()[key]
+    if (!entry || entry.url !== url) return null
+    entry.lastUsed = Date.now()
+    recordGiftAssetHit()
+    scheduleSave()
+    revalidate(key)
+    return entry.path
+}
+
+/**
+ * 取礼物资源本地路径：命中且文件存在时直接返回，文件已丢失时删除条目后重新下载，
+ * 未命中（或正在预取）时等待下载完成
+ * @param {string} url - 礼物 resourceURL
+ * @returns {Promise<string>} 本地绝对路径
+ */
+export async function getGiftAsset(url: string): Promise<string> {
+    const key = hashURL(url)
+    const entry = loadIndex()[key]
+    if (entry && entry.url === url && !(await fileExists(entry.path)) && loadIndex()[key] === entry) {
+        removeEntry(key)
+    }
+    return getCachedGiftAsset(url) || download(url, key, 'high')
+}
+
+function runPrefetch(): void {
+    while (prefetchRunning < PREFETCH_CONCURRENCY && prefetchQueue.length > 0) {
+        if (totalBytes() >= budgetBytes * PREFETCH_FILL_RATIO) {
+            prefetchQueue = []
+            return
+        }
+        const url = prefetchQueue.shift() as string
+        const key = hashURL(url)
+        if (loadIndex()[key]?.url === url || pending.has(key)) continue
+        prefetchRunning++
+        download(url, key, 'low')
+            .catch((error) => console.warn('giftAssetCache prefetch error:', error))
+            .finally(() => {
+                prefetchRunning--
+                runPrefetch()
+            })
+    }
+}
+
+/**
+ * 后台预取礼物资源，按金币从高到低排队，替换尚未开始的预取；已缓存的资源跳过，
+ * 缓存占用达到预算的 80% 后停止
+ * @param {PrefetchGift[]} gifts - 扁平礼物列表
+ */
+export function prefetchGiftAssets(gifts: PrefetchGift[]): void {
+    const urls = (gifts || [])
+        .filter((gift) => !!gift && !!gift.resourceURL)
+        .sort((a, b) => (b.coins || 0) - (a.coins || 0))
+        .map((gift) => `${gift.resourceURL}`)
+    prefetchQueue = urls.filter((url, i) => urls.indexOf(url) === i)
+    runPrefetch()
+}
+
+/**
+ * 设置缓存字节预算，缩小时立即淘汰
+ * @param {number} bytes - 预算字节数，小于等于 0 时恢复默认 64MB
+ */
+export function setGiftAssetCacheBudget(bytes: number): void {
+    budgetBytes = bytes > 0 ? bytes : DEFAULT_BUDGET_BYTES
+    evict()
+}
+
+/**
+ * 清空缓存并删除本地文件
+ */
+export function clearGiftAssetCache(): void {
+    prefetchQueue = []
+    Object.keys(loadIndex()).forEach(removeEntry)
+}
+
+/**
+ * 展开分类结构的礼物列表，兼容旧的扁平结构
+ */
+export function flattenGiftList(list: any[]): PrefetchGift[] {
+    if (!Array.isArray(list)) return []
+    if (list.length > 0 && list[0] && Array.isArray(list[0].giftList)) {
+        return list.reduce((out: PrefetchGift[], category) => out.concat(category.giftList || []), [])
+    }
+    return list
+}
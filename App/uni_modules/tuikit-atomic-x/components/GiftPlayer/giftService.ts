@@ -1,5 +1,6 @@
-import { ref } from 'vue'
+import { ref, watch } from 'vue'
 import { useGiftState } from '@/uni_modules/tuikit-atomic-x/state/GiftState'
+import { prefetchGiftAssets, flattenGiftList } from './giftAssetCache'
 
 type GiftData = {
     giftID?: string
@@ -16,9 +17,12 @@ export function giftService(params: {
     giftToastRef?: any
     autoHideMs?: number
 }) {
-    const { sendGift } = useGiftState(uni?.$liveID)
+    const { sendGift, usableGifts } = useGiftState(uni?.$liveID)
     const isGiftPlaying = ref(false)
 
+    // 礼物目录下发（含快照）后在后台预取动画资源
+    watch(usableGifts, (gifts) => prefetchGiftAssets(flattenGiftList(gifts)), { immediate: true })
+
     const showGift = async (giftData: GiftData, options?: { onlyDisplay?: boolean }) => {
         if (!giftData) return
         const onlyDisplay = !!options?.onlyDisplay
@@ -58,11 +62,299 @@ export function giftService(params: {
 }
 
 /**
- * 下载文件并保存到自定义路径
+ * 礼物资源下载管理：同一 URL 的并发请求共用一次下载，同时进行的下载数受限，排队时高优先级（播放）先于低优先级（预取）。
+ * 下载按 Range 分片写入临时文件，分片失败时从已写入的位置续传重试，应用重启后按记录的 ETag 从临时文件末尾续传；
+ * 服务端不支持 Range（返回 200）时整个响应一次写入。完成的文件名带版本，重新下载不会覆盖正在播放的旧文件
+ */
+export type DownloadPriority = 'high' | 'low'
+
+export type GiftDownloadMetrics = {
+    hits: number          // 资源缓存命中次数（由 giftAssetCache 上报）
+    joins: number         // 加入进行中或排队中下载的次数
+    downloads: number     // 实际发起的下载数
+    failures: number      // 重试耗尽后失败的下载数
+    retries: number       // 分片重试（续传）次数
+    bytesFetched: number  // 从网络读取的字节数
+    active: number        // 进行中的下载数
+    queued: number        // 排队中的下载数
+}
+
+export type GiftDownload = {
+    path: string   // 本地绝对路径
+    etag?: string  // 响应中的 ETag（去掉引号与弱校验前缀），拿不到响应头的下载方式为 undefined
+}
+
+type DownloadJob = {
+    url: string
+    priority: DownloadPriority
+    start: () => void
+}
+
+// 比预取并发多一个，预取占满时播放请求仍能立即开始
+const MAX_CONCURRENT_DOWNLOADS = 3
+const CHUNK_BYTES = 1024 * 1024
+const MAX_CHUNK_RETRIES = 3
+const RETRY_BASE_DELAY_MS = 500
+const CHUNK_TIMEOUT_MS = 15000
+const DOWNLOAD_DIR = '_doc/atomicx_gift/'
+// <hash>.part 对应的 ETag，应用重启后用于 If-Range 续传
+const PARTIAL_STORAGE_KEY = 'atomicx_gift_partial_downloads'
+
+const inflight = new Map<string, Promise<GiftDownload>>()
+const queue: DownloadJob[] = []
+let activeDownloads = 0
+let binaryWriteUnsupported = false
+const metrics = { hits: 0, joins: 0, downloads: 0, failures: 0, retries: 0, bytesFetched: 0 }
+
+/**
+ * URL 哈希（cyrb53），用作缓存 key 与下载文件名
+ */
+export function hashURL(url: string): string {
+    let h1 = 0xdeadbeef
+    let h2 = 0x41c6ce57
+    for (let i = 0; i < url.length; i++) {
+        const ch = url.charCodeAt(i)
+        h1 = Math.imul(h1 ^ ch, 2654435761)
+        h2 = Math.imul(h2 ^ ch, 1597334677)
+    }
+    h1 = Math.imul(h1 ^ (h1 >>> 16), 2246822507) ^ Math.imul(h2 ^ (h2 >>> 13), 3266489909)
+    h2 = Math.imul(h2 ^ (h2 >>> 16), 2246822507) ^ Math.imul(h1 ^ (h1 >>> 13), 3266489909)
+    return (h2 >>> 0).toString(16).padStart(8, '0') + (h1 >>> 0).toString(16).padStart(8, '0')
+}
+
+/**
+ * 记录一次资源缓存命中
+ */
+export function recordGiftAssetHit(): void {
+    metrics.hits++
+}
+
+/**
+ * 下载统计快照
+ * @return {GiftDownloadMetrics}
+ */
+export function getGiftDownloadMetrics(): GiftDownloadMetrics {
+    return { ...metrics, active: activeDownloads, queued: queue.length }
+}
+
+export function resetGiftDownloadMetrics(): void {
+    metrics.hits = 0
+    metrics.joins = 0
+    metrics.downloads = 0
+    metrics.failures = 0
+    metrics.retries = 0
+    metrics.bytesFetched = 0
+}
+
+/**
+ * 高优先级插到第一个低优先级任务之前，同优先级先进先出
+ */
+function enqueue(job: DownloadJob): void {
+    const firstLow = job.priority === 'high' ? queue.findIndex((item) => item.priority === 'low') : -1
+    queue.splice(firstLow < 0 ? queue.length : firstLow, 0, job)
+}
+
+/**
+ * 记录一次加入已有下载，高优先级加入时将排队中的低优先级任务提前；下载不存在时不发起新下载
  * @param {string} url - 文件网络地址
- * @return {Promise<string>} 返回文件本地绝对路径
+ * @param {DownloadPriority} priority - 加入方的优先级
  */
-export function downloadAndSaveToPath(url: string) {
+export function joinDownload(url: string, priority: DownloadPriority): void {
+    metrics.joins++
+    const queued = queue.findIndex((job) => job.url === url)
+    if (priority === 'high' && queued >= 0 && queue[queued].priority === 'low') {
+        const [job] = queue.splice(queued, 1)
+        job.priority = 'high'
+        enqueue(job)
+    }
+}
+
+function runQueue(): void {
+    while (activeDownloads < MAX_CONCURRENT_DOWNLOADS && queue.length > 0) {
+        activeDownloads++
+        ;(queue.shift() as DownloadJob).start()
+    }
+}
+
+function delay(ms: number): Promise<void> {
+    return new Promise((resolve) => setTimeout(resolve, ms))
+}
+
+function resolveEntry(path: string): Promise<any> {
+    return new Promise((resolve, reject) => plus.io.resolveLocalFileSystemURL(path, resolve, reject))
+}
+
+function getDownloadDir(): Promise<any> {
+    return resolveEntry('_doc/').then((root) => new Promise<any>((resolve, reject) =>
+        root.getDirectory('atomicx_gift', { create: true }, resolve, reject)))
+}
+
+/**
+ * 新建（覆盖）下载目录下的文件
+ */
+async function createFile(name: string): Promise<any> {
+    const dir = await getDownloadDir()
+    const old = await new Promise<any>((resolve) => dir.getFile(name, { create: false }, resolve, () => resolve(null)))
+    if (old) {
+        await new Promise((resolve, reject) => old.remove(resolve, reject))
+    }
+    return new Promise((resolve, reject) => dir.getFile(name, { create: true }, resolve, reject))
+}
+
+function loadPartials(): Record<string, string> {
+    try {
+        return (uni.getStorageSync(PARTIAL_STORAGE_KEY) as Record<string, string>) || {}
+    } catch (error) {
+        return {}
+    }
+}
+
+function savePartialETag(name: string, etag: string): void {
+    const partials = loadPartials()
+    if (etag) {
+        partials[name] = etag
+    } else {
+        delete partials[name]
+    }
+    uni.setStorageSync(PARTIAL_STORAGE_KEY, partials)
+}
+
+/**
+ * 打开上次未完成的 <hash>.part：有记录的 ETag 且文件非空时从文件末尾续传，否则新建
+ */
+async function openPartial(name: string): Promise<{ file: any, offset: number, etag: string }> {
+    const etag = loadPartials()[name] || ''
+    if (etag) {
+        const dir = await getDownloadDir()
+        const file = await new Promise<any>((resolve) => dir.getFile(`${name}.part`, { create: false }, resolve, () => resolve(null)))
+        const size = file ? await new Promise<number>((resolve) =>
+            file.getMetadata((meta: any) => resolve(meta.size || 0), () => resolve(0))) : 0
+        if (size > 0) {
+            return { file, offset: size, etag }
+        }
+    }
+    return { file: await createFile(`${name}.part`), offset: 0, etag: '' }
+}
+
+/**
+ * 在 offset 处写入一段二进制数据
+ */
+function writeChunk(file: any, offset: number, data: ArrayBuffer): Promise<void> {
+    return new Promise((resolve, reject) => {
+        file.createWriter((writer: any) => {
+            if (typeof writer.writeAsBinary !== 'function') {
+                binaryWriteUnsupported = true
+                reject(new Error('不支持二进制写入'))
+                return
+            }
+            writer.onwrite = () => resolve()
+            writer.onerror = () => reject(new Error('写入文件失败'))
+            writer.seek(offset)
+            writer.writeAsBinary(uni.arrayBufferToBase64(data))
+        }, reject)
+    })
+}
+
+type RangeResponse = {
+    data: ArrayBuffer
+    statusCode: number
+    total: number   // 资源总大小，未知时为 -1
+    etag: string    // 强校验 ETag，用作后续分片的 If-Range
+    tag: string     // 去掉引号与弱校验前缀的 ETag，作为缓存校验的资源版本
+}
+
+function requestRange(url: string, from: number, etag: string): Promise<RangeResponse> {
+    const header: Record<string, string> = { Range: `bytes=${from}-${from + CHUNK_BYTES - 1}` }
+    if (etag) {
+        // 资源在分片之间发生变化时服务端返回 200 全量，从头写入
+        header['If-Range'] = etag
+    }
+    return new Promise((resolve, reject) => {
+        uni.request({
+            url,
+            header,
+            responseType: 'arraybuffer',
+            timeout: CHUNK_TIMEOUT_MS,
+            success: (res) => {
+                const headers = (res.header || {}) as Record<string, string>
+                const contentRange = headers['Content-Range'] || headers['content-range'] || ''
+                const match = /\/(\d+)$/.exec(contentRange)
+                const etag = headers.ETag || headers.Etag || headers.etag || ''
+                if (res.statusCode === 206 || res.statusCode === 200) {
+                    const data = res.data as ArrayBuffer
+                    resolve({
+                        data,
+                        statusCode: res.statusCode,
+                        total: match ? Number(match[1]) : (res.statusCode === 200 ? data.byteLength : -1),
+                        etag: etag.startsWith('W/') ? '' : etag,
+                        tag: etag.replace(/^W\//, '').replace(/"/g, ''),
+                    })
+                } else if (res.statusCode === 416 && match) {
+                    resolve({ data: new ArrayBuffer(0), statusCode: 416, total: Number(match[1]), etag: '', tag: '' })
+                } else {
+                    reject(new Error(`下载失败 ${res.statusCode}`))
+                }
+            },
+            fail: reject,
+        })
+    })
+}
+
+/**
+ * 分片下载到 <hash>.part，完成后重命名为 <hash>-<版本>.svga，由缓存索引切换到新文件后再删除旧文件。
+ * 每个分片失败后从当前 offset 续传，退避重试 MAX_CHUNK_RETRIES 次；拿到强校验 ETag 后记录下来，
+ * 下载中断（包括应用退出）后下次从 .part 末尾以 If-Range 续传，资源已变化时服务端返回 200 全量并从头写入
+ */
+async function downloadRanged(url: string): Promise<GiftDownload> {
+    const name = hashURL(url)
+    let { file, offset, etag } = await openPartial(name)
+    let total = -1
+    let retries = 0
+    let tag = ''
+    while (total < 0 || offset < total) {
+        let res: RangeResponse
+        try {
+            res = await requestRange(url, offset, etag)
+        } catch (error) {
+            if (retries >= MAX_CHUNK_RETRIES) throw error
+            retries++
+            metrics.retries++
+            await delay(RETRY_BASE_DELAY_MS * Math.pow(2, retries - 1))
+            continue
+        }
+        retries = 0
+        tag = res.tag || tag
+        if (res.statusCode === 416) {
+            break
+        }
+        if (res.statusCode === 200 && offset > 0) {
+            // If-Range 不匹配（资源已变化）：整个响应即新文件，丢弃已写入的旧分片
+            file = await createFile(`${name}.part`)
+            offset = 0
+        }
+        await writeChunk(file, offset, res.data)
+        metrics.bytesFetched += res.data.byteLength
+        offset += res.data.byteLength
+        total = res.total
+        if (res.statusCode === 200 || res.data.byteLength === 0) {
+            break
+        }
+        if (!etag && res.etag) {
+            etag = res.etag
+            savePartialETag(name, etag)
+        }
+    }
+    savePartialETag(name, '')
+    const target = `${name}-${Date.now().toString(36)}.svga`
+    const dir = await getDownloadDir()
+    await new Promise((resolve, reject) => file.moveTo(dir, target, resolve, reject))
+    return { path: plus.io.convertLocalFileSystemURL(`${DOWNLOAD_DIR}${target}`), etag: tag }
+}
+
+/**
+ * 不支持二进制写入时的整文件下载，失败不续传
+ */
+function downloadWhole(url: string): Promise<GiftDownload> {
     return new Promise((resolve, reject) => {
         uni.downloadFile({
             url: url,
@@ -71,13 +363,14 @@ export function downloadAndSaveToPath(url: string) {
                     reject(new Error('下载失败'))
                     return
                 }
-                let imageFilePath = ''
+                uni.getFileInfo({
+                    filePath: res.tempFilePath,
+                    success: (info) => { metrics.bytesFetched += info.size },
+                })
                 uni.saveFile({
                     tempFilePath: res.tempFilePath,
                     success: (res) => {
-                        imageFilePath = res.savedFilePath
-                        imageFilePath = plus.io.convertLocalFileSystemURL(imageFilePath)
-                        resolve(imageFilePath)
+                        resolve({ path: plus.io.convertLocalFileSystemURL(res.savedFilePath) })
                     },
                     fail: () => {
                         reject(new Error('保存文件失败'))
@@ -88,3 +381,56 @@ export function downloadAndSaveToPath(url: string) {
         })
     })
 }
+
+function supportsBinaryWrite(): boolean {
+    return !binaryWriteUnsupported && typeof plus !== 'undefined' && !!plus.io && typeof uni.arrayBufferToBase64 === 'function'
+}
+
+/**
+ * 下载礼物资源并保存到下载目录，同时返回响应中的 ETag。同一 URL 下载未完成时再次调用共用同一个 Promise，
+ * 以高优先级加入排队中的低优先级下载时将其提前
+ * @param {string} url - 文件网络地址
+ * @param {DownloadPriority} [priority] - 排队优先级，播放用 high（默认），预取用 low
+ * @return {Promise<GiftDownload>} 本地绝对路径与 ETag
+ */
+export function downloadGiftAsset(url: string, priority: DownloadPriority = 'high'): Promise<GiftDownload> {
+    const existing = inflight.get(url)
+    if (existing) {
+        joinDownload(url, priority)
+        return existing
+    }
+    const task = new Promise<GiftDownload>((resolve, reject) => {
+        const job: DownloadJob = {
+            url,
+            priority,
+            start: () => {
+                metrics.downloads++
+                const run = supportsBinaryWrite()
+                    ? downloadRanged(url).catch((error) => binaryWriteUnsupported ? downloadWhole(url) : Promise.reject(error))
+                    : downloadWhole(url)
+                run.then(resolve, (error) => {
+                    metrics.failures++
+                    reject(error)
+                }).finally(() => {
+                    inflight.delete(url)
+                    activeDownloads--
+                    runQueue()
+                })
+            },
+        }
+        enqueue(job)
+    })
+    inflight.set(url, task)
+    runQueue()
+    return task
+}
+
+/**
+ * 下载文件并保存到自定义路径，规则同 downloadGiftAsset
+ * @param {string} url - 文件网络地址
+ * @param {DownloadPriority} [priority] - 排队优先级，播放用 high（默认），预取用 low
+ * @return {Promise<string>} 返回文件本地绝对路径
+ */
+export function downloadAndSaveToPath(url: string, priority: DownloadPriority = 'high'): Promise<string> {
+    return downloadGiftAsset(url, priority).then((result) => result.path)
+}
@@ -7,7 +7,7 @@ import {
     SetAudioChangerTypeOptions, SetAudioReverbTypeOptions, SetVoiceEarMonitorEnableOptions,
     VolumeOptions, AudioChangerTypeParam, AudioReverbTypeParam
 } from "@/uni_modules/tuikit-atomic-x";
-import { getRTCRoomEngineManager } from "./rtcRoomEngine";
+import { bindStoreEvent } from "./rtcRoomEngine";
 import { callUTSFunction, safeJsonParse } from "../utils/utsUtils";
 
 /**
@@ -174,7 +174,7 @@ function mapReverbTypeCodeToReverbType(typeCode : number) : AudioReverbTypeParam
 }
 
 function bindEvent(liveID : string) : void {
-    getRTCRoomEngineManager().on("audioEffectStoreChanged", onAudioEffectStoreChanged, liveID);
+    bindStoreEvent("audioEffectStoreChanged", onAudioEffectStoreChanged, liveID);
 }
 
 export function useAudioEffectState(liveID : string) {
@@ -2,25 +2,46 @@
  * 弹幕管理模块
  * @module BarrageState
  */
-import { ref } from "vue";
+import { ref, Ref } from "vue";
 import {
     SendTextMessageOptions, SendCustomMessageOptions, BarrageParam
 } from "@/uni_modules/tuikit-atomic-x";
 
-import { getRTCRoomEngineManager } from "./rtcRoomEngine";
+import { useRoomState } from "./roomState";
+import { registerReplayCompactor } from "./rtcRoomEngine";
 import { callUTSFunction, safeJsonParse } from "../utils/utsUtils";
+import { promisifyUTSCall } from "../utils/asyncCall";
+import { WireSchema, decodeWireRows, parseWireList } from "../utils/wireCodec";
+import { applyUserProfiles, resolveUser } from "../utils/userTable";
 
 /**
- * 弹幕消息列表
- * @type {Ref<BarrageParam[]>}
+ * 单个直播间的弹幕状态
+ * @typedef {Object} BarrageRoomState
+ * @property {Ref<BarrageParam[]>} messageList - 弹幕消息列表
+ * @property {Ref<boolean>} allowSendMessage - 是否允许发送消息
  */
-const messageList = ref<BarrageParam[]>([]);
+type BarrageRoomState = {
+    messageList : Ref<BarrageParam[]>;
+    allowSendMessage : Ref<boolean>;
+};
+
+function createBarrageRoomState() : BarrageRoomState {
+    return {
+        messageList: ref<BarrageParam[]>([]),
+        allowSendMessage: ref<boolean>(false),
+    };
+}
 
 /**
- * 是否允许发送消息
- * @type {Ref<boolean>}
+ * 弹幕增量数据，native 侧只下发上次同步后追加的消息
+ * @typedef {Object} BarrageDelta
+ * @property {number} total - native 侧消息列表当前长度，超出部分从头部裁剪
+ * @property {BarrageParam[]} messages - 新追加的消息，按 sequence 顺序
  */
-const allowSendMessage = ref<boolean>(false);
+type BarrageDelta = {
+    total : number;
+    messages : BarrageParam[];
+};
 
 /**
  * 发送文本消息
@@ -50,31 +71,99 @@ function sendCustomMessage(params : SendCustomMessageOptions) : void {
     callUTSFunction("sendCustomMessage", params);
 }
 
-const onBarrageStoreChanged = (eventName : string, res : string) : void => {
+/**
+ * 将增量消息原地追加到列表，并按 native 侧列表长度裁剪头部
+ * @param {BarrageParam[]} list - 弹幕列表（messageList 或回放快照）
+ * @param {BarrageDelta} delta - 弹幕增量数据
+ * @returns {BarrageParam[]} 追加后的列表
+ */
+function applyBarrageDelta(list : BarrageParam[], delta : BarrageDelta) : BarrageParam[] {
+    if (delta.messages?.length) {
+        list.push(...delta.messages);
+    }
+    if (delta.total >= 0 && list.length > delta.total) {
+        list.splice(0, list.length - delta.total);
+    }
+    return list;
+}
+
+/**
+ * 开启用户资料驻留时 sender 为句柄，还原为共享用户表中的资料对象
+ */
+function resolveSenders(messages : BarrageParam[]) : BarrageParam[] {
+    messages.forEach((message) => {
+        const sender : unknown = message.sender;
+        if (typeof sender === "number") {
+            message.sender = resolveUser(sender);
+        }
+    });
+    return messages;
+}
+
+/**
+ * 解析 messageListAppend 数据（紧凑格式首部为 [total]），sender 已还原
+ */
+function parseBarrageDelta(res : string) : BarrageDelta {
+    const wire = decodeWireRows<BarrageParam>(res, WireSchema.barrage, 1);
+    const data = wire ? { total: wire.header[0], messages: wire.rows }
+        : safeJsonParse<BarrageDelta>(res, { total: -1, messages: [] });
+    resolveSenders(data.messages || []);
+    return data;
+}
+
+/**
+ * 解析 messageListReset 数据，sender 已还原
+ */
+function parseBarrageList(res : string) : BarrageParam[] {
+    return resolveSenders(parseWireList<BarrageParam>(res, WireSchema.barrage));
+}
+
+registerReplayCompactor("messageListReset", {
+    decode: parseBarrageList,
+    apply: (list, deltaKey, res) => applyBarrageDelta(list, parseBarrageDelta(res)),
+});
+
+const onBarrageStoreChanged = (room : BarrageRoomState, eventName : string, res : string) : void => {
     try {
-        if (eventName === "messageList") {
-            const data = safeJsonParse<BarrageParam[]>(res, []);
-            messageList.value = data;
+        if (eventName === "userProfiles") {
+            applyUserProfiles(res);
+        } else if (eventName === "messageListAppend") {
+            applyBarrageDelta(room.messageList.value, parseBarrageDelta(res));
+        } else if (eventName === "messageListReset") {
+            room.messageList.value = parseBarrageList(res);
         } else if (eventName === "allowSendMessage") {
             const data = safeJsonParse<boolean>(res, false);
-            allowSendMessage.value = data;
+            room.allowSendMessage.value = data;
         }
     } catch (error) {
         console.error("onBarrageStoreChanged JSON parse error:", error);
     }
 };
 
-function bindEvent(liveID : string) {
-    getRTCRoomEngineManager().on("barrageStoreChanged", onBarrageStoreChanged, liveID);
-}
+/**
+ * Promise 版本的操作方法：参数同回调版本（不含 success/fail），第二个参数可传 { timeout, signal }，
+ * 失败、超时或取消时以 UTSCallError 拒绝
+ * @memberof module:BarrageState
+ * @example
+ * import { useBarrageState } from '@/uni_modules/tuikit-atomic-x/state/BarrageState';
+ * const { sendTextMessageAsync } = useBarrageState('your_live_id');
+ * await sendTextMessageAsync({ liveID: 'your_live_id', text: 'Hello World' });
+ */
+const sendTextMessageAsync = promisifyUTSCall("sendTextMessage", sendTextMessage);
+const sendCustomMessageAsync = promisifyUTSCall("sendCustomMessage", sendCustomMessage);
+
 export function useBarrageState(liveID : string) {
-    bindEvent(liveID);
+    const room = useRoomState(liveID, "barrageStoreChanged", createBarrageRoomState, onBarrageStoreChanged,
+        room => room.messageList.value);
     return {
-        messageList,         // 弹幕消息列表
+        messageList: room.messageList, // 弹幕消息列表
 
         // allowSendMessage,    // 是否允许发送消息 TODO：待支持
         sendTextMessage,     // 发送文本消息方法
-        sendCustomMessage    // 发送自定义消息方法
+        sendCustomMessage,   // 发送自定义消息方法
+
+        sendTextMessageAsync, // 发送文本消息（Promise）
+        sendCustomMessageAsync, // 发送自定义消息（Promise）
     };
 }
 
@@ -4,7 +4,7 @@
  */
 import { ref } from "vue";
 import { SetSmoothLevelOptions, SetWhitenessLevelOptions, SetRuddyLevelOptions } from "@/uni_modules/tuikit-atomic-x";
-import { getRTCRoomEngineManager } from "./rtcRoomEngine";
+import { bindStoreEvent } from "./rtcRoomEngine";
 import { callUTSFunction, safeJsonParse } from "../utils/utsUtils";
 
 /**
@@ -105,7 +105,7 @@ const onBeautyStoreChanged = (eventName: string, res: string): void => {
 };
 
 function bindEvent(liveID: string): void {
-    getRTCRoomEngineManager().on("beautyStoreChanged", onBeautyStoreChanged, liveID);
+    bindStoreEvent("beautyStoreChanged", onBeautyStoreChanged, liveID);
 }
 
 export function useBaseBeautyState(liveID: string) {
@@ -2,42 +2,41 @@
  * 连麦嘉宾状态管理
  * @module CoGuestState
  */
-import { ref } from "vue";
+import { ref, Ref } from "vue";
 import {
   ApplyForSeatOptions, CancelApplicationOptions, AcceptApplicationOptions, RejectApplicationOptions,
   InviteToSeatOptions, CancelInvitationOptions, AcceptInvitationOptions, RejectInvitationOptions, DisconnectOptions,
   LiveUserInfoParam, SeatUserInfoParam, ILiveListener,
 } from "@/uni_modules/tuikit-atomic-x";
 import { getRTCRoomEngineManager } from "./rtcRoomEngine";
+import { useRoomState } from "./roomState";
 import { callUTSFunction, safeJsonParse } from "../utils/utsUtils";
+import { promisifyUTSCall } from "../utils/asyncCall";
 
 /**
- * 已连接的连麦嘉宾列表
- * @type {Ref<SeatUserInfoParam[]>}
+ * 单个直播间的连麦嘉宾状态
+ * @typedef {Object} CoGuestRoomState
+ * @property {Ref<SeatUserInfoParam[]>} connected - 已连接的连麦嘉宾列表
+ * @property {Ref<LiveUserInfoParam[]>} invitees - 被邀请上麦的用户列表
+ * @property {Ref<LiveUserInfoParam[]>} applicants - 申请上麦的用户列表
+ * @property {Ref<LiveUserInfoParam[]>} candidates - 可邀请上麦的候选用户列表
  * @memberof module:CoGuestState
  */
-const connected = ref<SeatUserInfoParam[]>([]);
-
-/**
- * 被邀请上麦的用户列表
- * @type {Ref<LiveUserInfoParam[]>}
- * @memberof module:CoGuestState
- */
-const invitees = ref<LiveUserInfoParam[]>([]);
-
-/**
- * 申请上麦的用户列表
- * @type {Ref<LiveUserInfoParam[]>}
- * @memberof module:CoGuestState
- */
-const applicants = ref<LiveUserInfoParam[]>([]);
+type CoGuestRoomState = {
+  connected: Ref<SeatUserInfoParam[]>;
+  invitees: Ref<LiveUserInfoParam[]>;
+  applicants: Ref<LiveUserInfoParam[]>;
+  candidates: Ref<LiveUserInfoParam[]>;
+};
 
-/**
- * 可邀请上麦的候选用户列表
- * @type {Ref<LiveUserInfoParam[]>}
- * @memberof module:CoGuestState
- */
-const candidates = ref<LiveUserInfoParam[]>([]);
+function createCoGuestRoomState(): CoGuestRoomState {
+  return {
+    connected: ref<SeatUserInfoParam[]>([]),
+    invitees: ref<LiveUserInfoParam[]>([]),
+    applicants: ref<LiveUserInfoParam[]>([]),
+    candidates: ref<LiveUserInfoParam[]>([]),
+  };
+}
 
 /**
  * 申请连麦座位
@@ -233,38 +232,55 @@ function removeCoGuestHostListener(liveID: string, eventName: string, listener:
   getRTCRoomEngineManager().removeCoGuestHostListener(liveID, eventName, listener);
 }
 
-const onCoGuestStoreChanged = (eventName: string, res: string): void => {
+const onCoGuestStoreChanged = (room: CoGuestRoomState, eventName: string, res: string): void => {
   try {
     if (eventName === "connected") {
       const data = safeJsonParse<SeatUserInfoParam[]>(res, []);
-      connected.value = data;
+      room.connected.value = data;
     } else if (eventName === "invitees") {
       const data = safeJsonParse<LiveUserInfoParam[]>(res, []);
-      invitees.value = data;
+      room.invitees.value = data;
     } else if (eventName === "applicants") {
       const data = safeJsonParse<LiveUserInfoParam[]>(res, []);
-      applicants.value = data;
+      room.applicants.value = data;
     } else if (eventName === "candidates") {
       const data = safeJsonParse<LiveUserInfoParam[]>(res, []);
-      candidates.value = data;
+      room.candidates.value = data;
     }
   } catch (error) {
     console.error("onCoGuestStoreChanged error:", error);
   }
 };
 
-function bindEvent(liveID: string): void {
-  getRTCRoomEngineManager().on("coGuestStoreChanged", onCoGuestStoreChanged, liveID);
-}
+/**
+ * Promise 版本的操作方法：参数同回调版本（不含 success/fail），第二个参数可传 { timeout, signal }，
+ * 失败、超时或取消时以 UTSCallError 拒绝
+ * @memberof module:CoGuestState
+ * @example
+ * import { useCoGuestState } from '@/uni_modules/tuikit-atomic-x/state/CoGuestState';
+ * import { createAbortController } from '@/uni_modules/tuikit-atomic-x/utils/asyncCall';
+ * const { applyForSeatAsync } = useCoGuestState('your_live_id');
+ * const controller = createAbortController();
+ * await applyForSeatAsync({ liveID: 'your_live_id', seatIndex: -1 }, { signal: controller.signal });
+ */
+const applyForSeatAsync = promisifyUTSCall("applyForSeat", applyForSeat);
+const cancelApplicationAsync = promisifyUTSCall("cancelApplication", cancelApplication);
+const acceptApplicationAsync = promisifyUTSCall("acceptApplication", acceptApplication);
+const rejectApplicationAsync = promisifyUTSCall("rejectApplication", rejectApplication);
+const inviteToSeatAsync = promisifyUTSCall("inviteToSeat", inviteToSeat);
+const cancelInvitationAsync = promisifyUTSCall("cancelInvitation", cancelInvitation);
+const acceptInvitationAsync = promisifyUTSCall("acceptInvitation", acceptInvitation);
+const rejectInvitationAsync = promisifyUTSCall("rejectInvitation", rejectInvitation);
+const disconnectAsync = promisifyUTSCall("disconnect", disconnect);
 
 export function useCoGuestState(liveID: string) {
-  bindEvent(liveID);
+  const room = useRoomState(liveID, "coGuestStoreChanged", createCoGuestRoomState, onCoGuestStoreChanged);
 
   return {
-    connected,                 // 已连接的连麦嘉宾列表
-    invitees,                  // 被邀请上麦的用户列表
-    applicants,                // 申请上麦的用户列表
-    candidates,                // 可邀请上麦的候选用户列表
+    connected: room.connected, // 已连接的连麦嘉宾列表
+    invitees: room.invitees,   // 被邀请上麦的用户列表
+    applicants: room.applicants, // 申请上麦的用户列表
+    candidates: room.candidates, // 可邀请上麦的候选用户列表
 
     applyForSeat,              // 申请连麦座位
     cancelApplication,         // 取消申请
@@ -280,6 +296,16 @@ export function useCoGuestState(liveID: string) {
     removeCoGuestGuestListener,// 移除嘉宾侧事件监听
     addCoGuestHostListener,    // 添加主播侧事件监听
     removeCoGuestHostListener, // 移除主播侧事件监听
+
+    applyForSeatAsync,         // 申请连麦座位（Promise）
+    cancelApplicationAsync,    // 取消申请（Promise）
+    acceptApplicationAsync,    // 接受申请（Promise）
+    rejectApplicationAsync,    // 拒绝申请（Promise）
+    inviteToSeatAsync,         // 邀请上麦（Promise）
+    cancelInvitationAsync,     // 取消邀请（Promise）
+    acceptInvitationAsync,     // 接受邀请（Promise）
+    rejectInvitationAsync,     // 拒绝邀请（Promise）
+    disconnectAsync,           // 断开连麦连接（Promise）
   };
 }
 
@@ -2,49 +2,44 @@
  * 连麦主播状态管理
  * @module CoHostState
  */
-import { ref } from "vue";
+import { ref, Ref } from "vue";
 import {
   LiveUserInfoParam,
   RequestHostConnectionOptions, CancelHostConnectionOptions, AcceptHostConnectionOptions,
   RejectHostConnectionOptions, ExitHostConnectionOptions, ILiveListener
 } from "@/uni_modules/tuikit-atomic-x";
 import { getRTCRoomEngineManager } from "./rtcRoomEngine";
+import { useRoomState } from "./roomState";
 import { callUTSFunction, safeJsonParse } from "../utils/utsUtils";
+import { promisifyUTSCall } from "../utils/asyncCall";
 
 /**
- * 已连接的连麦主播列表
- * @type {Ref<LiveUserInfoParam[]>}
+ * 单个直播间的连麦主播状态
+ * @typedef {Object} CoHostRoomState
+ * @property {Ref<LiveUserInfoParam[]>} connected - 已连接的连麦主播列表
+ * @property {Ref<LiveUserInfoParam[]>} invitees - 被邀请连麦的主播列表
+ * @property {Ref<LiveUserInfoParam | undefined>} applicant - 当前申请连麦的主播信息
+ * @property {Ref<LiveUserInfoParam[]>} candidates - 可邀请连麦的候选主播列表
+ * @property {Ref<string>} coHostStatus - 当前连麦状态
  * @memberof module:CoHostState
  */
-const connected = ref<LiveUserInfoParam[]>([]);
-
-/**
- * 被邀请连麦的主播列表
- * @type {Ref<LiveUserInfoParam[]>}
- * @memberof module:CoHostState
- */
-const invitees = ref<LiveUserInfoParam[]>([]);
-
-/**
- * 当前申请连麦的主播信息
- * @type {Ref<LiveUserInfoParam | undefined>}
- * @memberof module:CoHostState
- */
-const applicant = ref<LiveUserInfoParam | undefined>();
-
-/**
- * 可邀请连麦的候选主播列表
- * @type {Ref<LiveUserInfoParam[]>}
- * @memberof module:CoHostState
- */
-const candidates = ref<LiveUserInfoParam[]>([]);
+type CoHostRoomState = {
+  connected: Ref<LiveUserInfoParam[]>;
+  invitees: Ref<LiveUserInfoParam[]>;
+  applicant: Ref<LiveUserInfoParam | undefined>;
+  candidates: Ref<LiveUserInfoParam[]>;
+  coHostStatus: Ref<string>;
+};
 
-/**
- * 当前连麦状态
- * @type {Ref<string>}
- * @memberof module:CoHostState
- */
-const coHostStatus = ref<string>('')
+function createCoHostRoomState(): CoHostRoomState {
+  return {
+    connected: ref<LiveUserInfoParam[]>([]),
+    invitees: ref<LiveUserInfoParam[]>([]),
+    applicant: ref<LiveUserInfoParam | undefined>(),
+    candidates: ref<LiveUserInfoParam[]>([]),
+    coHostStatus: ref<string>(''),
+  };
+}
 
 /**
  * 请求连麦
@@ -150,40 +145,53 @@ function removeCoHostListener(liveID: string, eventName: string, listener: ILive
   getRTCRoomEngineManager().removeCoHostListener(liveID, eventName, listener);
 }
 
-const onCoHostStoreChanged = (eventName: string, res: string): void => {
+const onCoHostStoreChanged = (room: CoHostRoomState, eventName: string, res: string): void => {
   try {
     if (eventName === "connected") {
       const data = safeJsonParse<LiveUserInfoParam[]>(res, []);
-      connected.value = data;
+      room.connected.value = data;
     } else if (eventName === "invitees") {
       const data = safeJsonParse<LiveUserInfoParam[]>(res, []);
-      invitees.value = data;
+      room.invitees.value = data;
     } else if (eventName === "applicant") {
       const data = safeJsonParse<LiveUserInfoParam | null>(res, null);
-      applicant.value = data;
+      room.applicant.value = data;
     } else if (eventName === "candidates") {
       const data = safeJsonParse<LiveUserInfoParam[]>(res, []);
-      candidates.value = data;
+      room.candidates.value = data;
     } else if (eventName === "coHostStatus") {
-      coHostStatus.value = JSON.parse(res);
+      room.coHostStatus.value = JSON.parse(res);
     }
   } catch (error) {
     console.error("onCoHostStoreChanged error:", error);
   }
 };
 
-function bindEvent(liveID: string): void {
-  getRTCRoomEngineManager().on("coHostStoreChanged", onCoHostStoreChanged, liveID);
-}
+/**
+ * Promise 版本的操作方法：参数同回调版本（不含 success/fail），第二个参数可传 { timeout, signal }，
+ * 失败、超时或取消时以 UTSCallError 拒绝
+ * @memberof module:CoHostState
+ * @example
+ * import { useCoHostState } from '@/uni_modules/tuikit-atomic-x/state/CoHostState';
+ * import { createAbortController } from '@/uni_modules/tuikit-atomic-x/utils/asyncCall';
+ * const { requestHostConnectionAsync } = useCoHostState('your_live_id');
+ * const controller = createAbortController();
+ * await requestHostConnectionAsync({ liveID: 'your_live_id', targetHostLiveID: 'target_live_id' }, { signal: controller.signal });
+ */
+const requestHostConnectionAsync = promisifyUTSCall("requestHostConnection", requestHostConnection);
+const cancelHostConnectionAsync = promisifyUTSCall("cancelHostConnection", cancelHostConnection);
+const acceptHostConnectionAsync = promisifyUTSCall("acceptHostConnection", acceptHostConnection);
+const rejectHostConnectionAsync = promisifyUTSCall("rejectHostConnection", rejectHostConnection);
+const exitHostConnectionAsync = promisifyUTSCall("exitHostConnection", exitHostConnection);
 
 export function useCoHostState(liveID: string) {
-  bindEvent(liveID);
+  const room = useRoomState(liveID, "coHostStoreChanged", createCoHostRoomState, onCoHostStoreChanged);
 
   return {
-    coHostStatus,           // 当前连麦状态
-    connected,              // 已连接的连麦主播列表
-    invitees,               // 被邀请连麦的主播列表
-    applicant,              // 当前申请连麦的主播信息
+    coHostStatus: room.coHostStatus, // 当前连麦状态
+    connected: room.connected, // 已连接的连麦主播列表
+    invitees: room.invitees, // 被邀请连麦的主播列表
+    applicant: room.applicant, // 当前申请连麦的主播信息
     // candidates,          // 可邀请连麦的候选主播列表： TODO：待支持
 
     requestHostConnection,  // 请求连麦
@@ -194,6 +202,12 @@ export function useCoHostState(liveID: string) {
 
     addCoHostListener,      // 添加连麦事件监听
     removeCoHostListener,   // 移除连麦事件监听
+
+    requestHostConnectionAsync, // 请求连麦（Promise）
+    cancelHostConnectionAsync, // 取消连麦请求（Promise）
+    acceptHostConnectionAsync, // 接受连麦请求（Promise）
+    rejectHostConnectionAsync, // 拒绝连麦请求（Promise）
+    exitHostConnectionAsync, // 退出连麦（Promise）
   };
 }
 
@@ -7,9 +7,11 @@ import {
   OpenLocalMicrophoneOptions, SetAudioRouteOptions, OpenLocalCameraOptions, SwitchCameraOptions,
   UpdateVideoQualityOptions, SwitchMirrorOptions, VolumeOptions,
 } from "@/uni_modules/tuikit-atomic-x";
-import { getRTCRoomEngineManager } from "./rtcRoomEngine";
+import { bindStoreEvent } from "./rtcRoomEngine";
 import permission from "../utils/permission";
 import { callUTSFunction, safeJsonParse } from "../utils/utsUtils";
+import { promisifyUTSCall } from "../utils/asyncCall";
+import { WireSchema, parseWireObject } from "../utils/wireCodec";
 
 export const DeviceStatusCode = {
   OFF: 0,
@@ -250,6 +252,22 @@ function setOutputVolume(params: VolumeOptions): void {
   callUTSFunction("setOutputVolume", params);
 }
 
+/**
+ * 设置设备高频事件的最大下发频率，窗口内只保留最新值；默认 currentMicVolume、captureVolume 为 10 次/秒，networkInfo 为 1 次/秒，
+ * cameraStatus 等离散状态不限频
+ * @param {string} key - 事件名，如 'currentMicVolume'、'captureVolume'、'networkInfo'
+ * @param {number} maxRate - 每秒最多下发次数，小于等于 0 表示不限频
+ * @returns {void}
+ * @memberof module:DeviceState
+ * @example
+ * import { useDeviceState } from '@/uni_modules/tuikit-atomic-x/state/DeviceState';
+ * const { setDeviceEventRate } = useDeviceState();
+ * setDeviceEventRate('currentMicVolume', 5)
+ */
+function setDeviceEventRate(key: string, maxRate: number): void {
+  callUTSFunction("setStoreEventRate", { store: "Device", key, maxRate });
+}
+
 /**
  * 设置音频路由
  * @param {SetAudioRouteOptions} params - 音频路由参数
@@ -433,7 +451,7 @@ const onDeviceStoreChanged = (eventName: string, res: string): void => {
         console.error(`Invalid screen status code received: ${statusCode}`);
       }
     } else if (eventName === "networkInfo") {
-      networkInfo.value = safeJsonParse<any>(res, {});
+      networkInfo.value = parseWireObject<any>(res, WireSchema.networkInfo, {});
     }
   } catch (error) {
     console.error("onDeviceStoreChanged error:", error);
@@ -441,9 +459,21 @@ const onDeviceStoreChanged = (eventName: string, res: string): void => {
 };
 
 function bindEvent(): void {
-  getRTCRoomEngineManager().on("deviceStoreChanged", onDeviceStoreChanged, "");
+  bindStoreEvent("deviceStoreChanged", onDeviceStoreChanged, "");
 }
 
+/**
+ * Promise 版本的操作方法：参数同回调版本（不含 success/fail），第二个参数可传 { timeout, signal }，
+ * 失败、超时或取消时以 UTSCallError 拒绝
+ * @memberof module:DeviceState
+ * @example
+ * import { useDeviceState } from '@/uni_modules/tuikit-atomic-x/state/DeviceState';
+ * const { openLocalCameraAsync, openLocalMicrophoneAsync } = useDeviceState();
+ * await Promise.all([openLocalCameraAsync({ isFront: true }), openLocalMicrophoneAsync()]);
+ */
+const openLocalMicrophoneAsync = promisifyUTSCall("openLocalMicrophone", openLocalMicrophone);
+const openLocalCameraAsync = promisifyUTSCall("openLocalCamera", openLocalCamera);
+
 export function useDeviceState() {
   bindEvent();
 
@@ -469,6 +499,7 @@ export function useDeviceState() {
     setCaptureVolume,         // 设置采集音量
     setOutputVolume,          // 设置输出音量
     setAudioRoute,            // 设置音频路由
+    setDeviceEventRate,       // 设置高频事件下发频率
 
     openLocalCamera,          // 打开本地摄像头
     closeLocalCamera,         // 关闭本地摄像头
@@ -478,6 +509,9 @@ export function useDeviceState() {
 
     startScreenShare,         // 开始屏幕共享
     stopScreenShare,          // 停止屏幕共享
+
+    openLocalMicrophoneAsync, // 打开本地麦克风（Promise）
+    openLocalCameraAsync,     // 打开本地摄像头（Promise）
   };
 }
 
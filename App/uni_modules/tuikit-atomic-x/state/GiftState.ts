@@ -2,10 +2,13 @@
  * 礼物状态管理
  * @module GiftState
  */
-import { ref } from "vue";
+import { ref, Ref } from "vue";
 import { ILiveListener, RefreshUsableGiftsOptions, SendGiftOptions } from "@/uni_modules/tuikit-atomic-x";
 import { getRTCRoomEngineManager } from "./rtcRoomEngine";
+import { useRoomState, peekRoomState } from "./roomState";
 import { callUTSFunction, safeJsonParse } from "../utils/utsUtils";
+import { promisifyUTSCall } from "../utils/asyncCall";
+import { readSessionSnapshot, writeSessionSnapshot } from "../utils/sessionSnapshot";
 
 /**
  * 礼物参数类型定义
@@ -50,11 +53,27 @@ export type GiftCategoryParam = {
 };
 
 /**
- * 可用礼物列表
- * @type {Ref<GiftCategoryParam[]>}
+ * 单个直播间的礼物状态
+ * @typedef {Object} GiftRoomState
+ * @property {Ref<GiftCategoryParam[]>} usableGifts - 可用礼物列表
+ * @property {boolean} isFromSnapshot - usableGifts 是否仍为快照数据
  * @memberof module:GiftState
  */
-const usableGifts = ref<GiftCategoryParam[]>([]);
+type GiftRoomState = {
+    usableGifts : Ref<GiftCategoryParam[]>;
+    isFromSnapshot : boolean; // usableGifts 是否仍为快照中的礼物目录
+};
+
+/**
+ * 新直播间先用上次缓存的礼物目录渲染礼物面板，store 下发或刷新完成后替换
+ */
+function createGiftRoomState() : GiftRoomState {
+    const cachedGifts = readSessionSnapshot<GiftCategoryParam[]>("usableGifts") ?? [];
+    return {
+        usableGifts: ref<GiftCategoryParam[]>(cachedGifts),
+        isFromSnapshot: cachedGifts.length > 0,
+    };
+}
 
 /**
  * 刷新可用礼物列表
@@ -67,7 +86,16 @@ const usableGifts = ref<GiftCategoryParam[]>([]);
  * refreshUsableGifts({});
  */
 function refreshUsableGifts(params : RefreshUsableGiftsOptions) : void {
-    callUTSFunction("refreshUsableGifts", params);
+    callUTSFunction("refreshUsableGifts", {
+        ...params,
+        success: () => {
+            const room = peekRoomState<GiftRoomState>(params.liveID, "giftStoreChanged");
+            if (room) {
+                room.isFromSnapshot = false;
+            }
+            params.success?.();
+        },
+    });
 }
 
 /**
@@ -118,30 +146,49 @@ function removeGiftListener(liveID : string, eventName : string, listener : ILiv
     getRTCRoomEngineManager().removeGiftListener(liveID, eventName, listener);
 }
 
-const onGiftStoreChanged = (eventName : string, res : string) : void => {
+const onGiftStoreChanged = (room : GiftRoomState, eventName : string, res : string) : void => {
     try {
         if (eventName === "usableGifts") {
             const data = safeJsonParse<GiftCategoryParam[]>(res, []);
-            usableGifts.value = data;
+            if (data.length === 0 && room.isFromSnapshot) {
+                // 刷新完成前 store 的空目录不覆盖快照
+                return;
+            }
+            room.isFromSnapshot = false;
+            room.usableGifts.value = data;
+            if (data.length > 0) {
+                writeSessionSnapshot("usableGifts", data);
+            }
         }
     } catch (error) {
         console.error("onGiftStoreChanged JSON parse error:", error);
     }
 };
 
-function bindEvent(liveID : string) : void {
-    getRTCRoomEngineManager().on("giftStoreChanged", onGiftStoreChanged, liveID);
-}
+/**
+ * Promise 版本的操作方法：参数同回调版本（不含 success/fail），第二个参数可传 { timeout, signal }，
+ * 失败、超时或取消时以 UTSCallError 拒绝
+ * @memberof module:GiftState
+ * @example
+ * import { useGiftState } from '@/uni_modules/tuikit-atomic-x/state/GiftState';
+ * const { refreshUsableGiftsAsync } = useGiftState('your_live_id');
+ * await refreshUsableGiftsAsync({ liveID: 'your_live_id' });
+ */
+const refreshUsableGiftsAsync = promisifyUTSCall("refreshUsableGifts", refreshUsableGifts);
+const sendGiftAsync = promisifyUTSCall("sendGift", sendGift);
 
 export function useGiftState(liveID : string) {
-    bindEvent(liveID);
+    const room = useRoomState(liveID, "giftStoreChanged", createGiftRoomState, onGiftStoreChanged);
     return {
-        usableGifts,         // 可用礼物列表
+        usableGifts: room.usableGifts, // 可用礼物列表
 
         refreshUsableGifts,  // 刷新可用礼物列表
         sendGift,            // 发送礼物
         addGiftListener,     // 添加礼物事件监听
-        removeGiftListener   // 移除礼物事件监听
+        removeGiftListener,  // 移除礼物事件监听
+
+        refreshUsableGiftsAsync, // 刷新可用礼物列表（Promise）
+        sendGiftAsync,       // 发送礼物（Promise）
     };
 }
 export default useGiftState;
\ No newline at end of file
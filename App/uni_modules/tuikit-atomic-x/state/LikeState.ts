@@ -2,17 +2,28 @@
  * 点赞状态管理
  * @module LikeState
  */
-import { ref } from "vue";
+import { ref, Ref } from "vue";
 import { ILiveListener, SendLikeOptions } from "@/uni_modules/tuikit-atomic-x";
 import { getRTCRoomEngineManager } from "./rtcRoomEngine";
+import { useRoomState } from "./roomState";
 import { callUTSFunction, safeJsonParse } from "../utils/utsUtils";
+import { promisifyUTSCall } from "../utils/asyncCall";
 
 /**
- * 总点赞数量
- * @type {Ref<number>}
+ * 单个直播间的点赞状态
+ * @typedef {Object} LikeRoomState
+ * @property {Ref<number>} totalLikeCount - 总点赞数量
  * @memberof module:LikeState
  */
-const totalLikeCount = ref<number>(0);
+type LikeRoomState = {
+    totalLikeCount : Ref<number>;
+};
+
+function createLikeRoomState() : LikeRoomState {
+    return {
+        totalLikeCount: ref<number>(0),
+    };
+}
 
 /**
  * 发送点赞
@@ -62,28 +73,37 @@ function removeLikeListener(liveID : string, eventName : string, listener : ILiv
     getRTCRoomEngineManager().removeLikeListener(liveID, eventName, listener);
 }
 
-const onLikeStoreChanged = (eventName : string, res : string) : void => {
+const onLikeStoreChanged = (room : LikeRoomState, eventName : string, res : string) : void => {
     try {
         if (eventName === "totalLikeCount") {
             const data = safeJsonParse<number>(res, 0);
-            totalLikeCount.value = data;
+            room.totalLikeCount.value = data;
         }
     } catch (error) {
         console.error("onLikeStoreChanged JSON parse error:", error);
     }
 };
 
-function bindEvent(liveID : string) : void {
-    getRTCRoomEngineManager().on("likeStoreChanged", onLikeStoreChanged, liveID);
-}
+/**
+ * Promise 版本的操作方法：参数同回调版本（不含 success/fail），第二个参数可传 { timeout, signal }，
+ * 失败、超时或取消时以 UTSCallError 拒绝
+ * @memberof module:LikeState
+ * @example
+ * import { useLikeState } from '@/uni_modules/tuikit-atomic-x/state/LikeState';
+ * const { sendLikeAsync } = useLikeState('your_live_id');
+ * await sendLikeAsync({ liveID: 'your_live_id', count: 1 });
+ */
+const sendLikeAsync = promisifyUTSCall("sendLike", sendLike);
 
 export function useLikeState(liveID : string) {
-    bindEvent(liveID);
+    const room = useRoomState(liveID, "likeStoreChanged", createLikeRoomState, onLikeStoreChanged);
     return {
-        totalLikeCount,       // 总点赞数量
+        totalLikeCount: room.totalLikeCount, // 总点赞数量
         sendLike,             // 发送点赞
         addLikeListener,      // 添加点赞事件监听
         removeLikeListener,   // 移除点赞事件监听
+
+        sendLikeAsync,        // 发送点赞（Promise）
     };
 }
 export default useLikeState;
\ No newline at end of file
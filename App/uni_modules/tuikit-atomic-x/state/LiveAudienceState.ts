@@ -2,27 +2,58 @@
  * 直播间观众状态管理
  * @module LiveAudienceState
  */
-import { ref } from "vue";
+import { ref, Ref } from "vue";
 import {
-    FetchAudienceListOptions, SetAdministratorOptions, RevokeAdministratorOptions, KickUserOutOfRoomOptions,
+    FetchAudienceListOptions, FetchAudienceListPageOptions, SetAdministratorOptions, RevokeAdministratorOptions, KickUserOutOfRoomOptions,
     DisableSendMessageOptions, LiveUserInfoParam, ILiveListener
 } from "@/uni_modules/tuikit-atomic-x";
-import { getRTCRoomEngineManager } from "./rtcRoomEngine";
+import { getRTCRoomEngineManager, registerReplayCompactor } from "./rtcRoomEngine";
+import { peekRoomState, useRoomState } from "./roomState";
 import { callUTSFunction, safeJsonParse } from "../utils/utsUtils";
+import { promisifyUTSCall } from "../utils/asyncCall";
+import { isWirePayload } from "../utils/wireCodec";
+import { applyUserProfiles, parseUserList, resolveUser } from "../utils/userTable";
 
 /**
- * 直播间观众列表
- * @type {Ref<LiveUserInfoParam[]>}
+ * 单个直播间的观众状态
+ * @typedef {Object} LiveAudienceRoomState
+ * @property {Ref<LiveUserInfoParam[]>} audienceList - 直播间观众列表（窗口），窗口外的观众通过 fetchAudienceListPage 分页加载
+ * @property {Ref<number>} audienceListWindowSize - 观众名单窗口大小
+ * @property {Ref<number>} audienceListCursor - 观众列表分页游标
+ * @property {Ref<boolean>} hasMoreAudience - 是否还有未拉取的观众分页
+ * @property {Ref<number>} audienceCount - 直播间观众数量
  * @memberof module:LiveAudienceState
  */
-const audienceList = ref<LiveUserInfoParam[]>([]);
+type LiveAudienceRoomState = {
+    audienceList : Ref<LiveUserInfoParam[]>;
+    audienceListWindowSize : Ref<number>;
+    audienceListCursor : Ref<number>;
+    hasMoreAudience : Ref<boolean>;
+    audienceCount : Ref<number>;
+};
+
+function createLiveAudienceRoomState() : LiveAudienceRoomState {
+    return {
+        audienceList: ref<LiveUserInfoParam[]>([]),
+        audienceListWindowSize: ref<number>(100),
+        audienceListCursor: ref<number>(0),
+        hasMoreAudience: ref<boolean>(true),
+        audienceCount: ref<number>(0),
+    };
+}
 
 /**
- * 直播间观众数量
- * @type {Ref<number>}
- * @memberof module:LiveAudienceState
+ * 观众名单增量数据
+ * @typedef {Object} AudienceListDelta
+ * @property {LiveUserInfoParam[]} joined - 新进入的观众
+ * @property {string[]} left - 离开的观众 userID
+ * @property {LiveUserInfoParam[]} updated - 窗口内资料变化的观众
  */
-const audienceCount = ref<number>(0);
+type AudienceListDelta = {
+    joined : LiveUserInfoParam[];
+    left : string[];
+    updated : LiveUserInfoParam[];
+};
 
 /**
  * 获取直播间观众列表
@@ -38,6 +69,156 @@ function fetchAudienceList(params ?: FetchAudienceListOptions) : void {
     callUTSFunction("fetchAudienceList", params || {});
 }
 
+/**
+ * 分页拉取观众列表，结果合并到观众名单窗口
+ * @param {FetchAudienceListPageOptions} params - 分页参数，未传 nextSequence 时使用当前游标
+ * @returns {void}
+ * @memberof module:LiveAudienceState
+ * @example
+ * import { useLiveAudienceState } from '@/uni_modules/tuikit-atomic-x/state/LiveAudienceState';
+ * const { fetchAudienceListPage, hasMoreAudience } = useLiveAudienceState("your_live_id");
+ * if (hasMoreAudience.value) fetchAudienceListPage({ liveID: "your_live_id" });
+ */
+function fetchAudienceListPage(params : FetchAudienceListPageOptions) : void {
+    const { success } = params;
+    const room = peekRoomState<LiveAudienceRoomState>(params.liveID, "liveAudienceStoreChanged");
+    callUTSFunction("fetchAudienceListPage", {
+        ...params,
+        nextSequence: params.nextSequence ?? room?.audienceListCursor.value ?? 0,
+        success: (data : string) => {
+            if (room) {
+                const page = safeJsonParse<{ audienceList : LiveUserInfoParam[], nextSequence : number }>(data,
+                    { audienceList: [], nextSequence: 0 });
+                appendAudiences(room, page.audienceList || [], true);
+                room.audienceListCursor.value = page.nextSequence || 0;
+                room.hasMoreAudience.value = !!page.nextSequence;
+            }
+            success?.(data);
+        },
+    });
+}
+
+/**
+ * 设置观众名单窗口大小，native 侧全量及单次新增下发的观众数量同步受限
+ * @param {string} liveID - 直播间ID
+ * @param {number} windowSize - JS 侧最多持有的观众数量
+ * @returns {void}
+ * @memberof module:LiveAudienceState
+ * @example
+ * import { useLiveAudienceState } from '@/uni_modules/tuikit-atomic-x/state/LiveAudienceState';
+ * const { setAudienceListWindowSize } = useLiveAudienceState("your_live_id");
+ * setAudienceListWindowSize("your_live_id", 50);
+ */
+function setAudienceListWindowSize(liveID : string, windowSize : number) : void {
+    const room = peekRoomState<LiveAudienceRoomState>(liveID, "liveAudienceStoreChanged");
+    if (room) {
+        room.audienceListWindowSize.value = Math.max(1, windowSize);
+        trimAudienceList(room, false);
+    }
+    callUTSFunction("setAudienceListWindow", { liveID, windowSize: Math.max(1, windowSize) });
+}
+
+/**
+ * 将观众合并到名单窗口，已存在的 userID 跳过
+ * @param {LiveAudienceRoomState} room - 直播间观众状态
+ * @param {LiveUserInfoParam[]} audiences - 待合并的观众
+ * @param {boolean} slide - 超出窗口时是否从头部淘汰（分页加载时窗口向后滑动）
+ */
+function appendAudiences(room : LiveAudienceRoomState, audiences : LiveUserInfoParam[], slide : boolean) : void {
+    const list = room.audienceList.value;
+    const existing = new Set(list.map(item => item.userID));
+    for (const audience of audiences) {
+        if (!slide && list.length >= room.audienceListWindowSize.value) {
+            break;
+        }
+        if (!existing.has(audience.userID)) {
+            existing.add(audience.userID);
+            list.push(audience);
+        }
+    }
+    trimAudienceList(room, slide);
+}
+
+function trimAudienceList(room : LiveAudienceRoomState, fromHead : boolean) : void {
+    const list = room.audienceList.value;
+    const overflow = list.length - room.audienceListWindowSize.value;
+    if (overflow > 0) {
+        list.splice(fromHead ? 0 : list.length - overflow, overflow);
+    }
+}
+
+/**
+ * 解析观众增量，紧凑格式为 ["c1", joinedRows, leftUserIDs, updatedRows]
+ */
+function parseAudienceListDelta(res : string) : AudienceListDelta {
+    if (!isWirePayload(res)) {
+        const delta = safeJsonParse<AudienceListDelta>(res, { joined: [], left: [], updated: [] });
+        delta.joined = (delta.joined || []).map((item : any) => resolveUser(item));
+        delta.updated = (delta.updated || []).map((item : any) => resolveUser(item));
+        return delta;
+    }
+    const [, joinedRows, left, updatedRows] = safeJsonParse<any[]>(res, []);
+    return {
+        joined: (joinedRows || []).map((row : any) => resolveUser(row)),
+        left: left || [],
+        updated: (updatedRows || []).map((row : any) => resolveUser(row)),
+    };
+}
+
+/**
+ * 按 userID 原地移除 left、替换 updated 中的观众
+ */
+function patchAudienceList(list : LiveUserInfoParam[], delta : AudienceListDelta) : LiveUserInfoParam[] {
+    if (delta.left?.length) {
+        const left = new Set(delta.left);
+        for (let i = list.length - 1; i >= 0; i--) {
+            if (left.has(list[i].userID)) {
+                list.splice(i, 1);
+            }
+        }
+    }
+    if (delta.updated?.length) {
+        const updated = new Map(delta.updated.map(user => [user.userID, user]));
+        for (let i = 0; i < list.length; i++) {
+            const user = updated.get(list[i].userID);
+            if (user) {
+                list.splice(i, 1, user);
+            }
+        }
+    }
+    return list;
+}
+
+/**
+ * 原地应用 left/updated/joined 增量。native 侧保证下发的观众不超过窗口（窗口满时暂缓下发新观众），
+ * 只有分页加载的观众占用窗口时才从头部淘汰
+ */
+function applyAudienceListDelta(room : LiveAudienceRoomState, delta : AudienceListDelta) : void {
+    patchAudienceList(room.audienceList.value, delta);
+    if (delta.joined?.length) {
+        appendAudiences(room, delta.joined, true);
+    }
+}
+
+/**
+ * 回放快照不按窗口裁剪：下发的观众已受 native 窗口约束，回放时由各房间按自身窗口截取
+ */
+registerReplayCompactor("audienceList", {
+    decode: parseUserList,
+    apply: (list, deltaKey, res) => {
+        const delta = parseAudienceListDelta(res);
+        patchAudienceList(list, delta);
+        const existing = new Set(list.map(item => item.userID));
+        (delta.joined || []).forEach((audience) => {
+            if (!existing.has(audience.userID)) {
+                existing.add(audience.userID);
+                list.push(audience);
+            }
+        });
+        return list;
+    },
+});
+
 /**
  * 设置管理员
  * @param {SetAdministratorOptions} params - 设置管理员参数
@@ -128,29 +309,52 @@ function removeAudienceListener(liveID : string, eventName : string, listener :
     getRTCRoomEngineManager().removeAudienceListener(liveID, eventName, listener);
 }
 
-const onLiveAudienceStoreChanged = (eventName : string, res : string) : void => {
+const onLiveAudienceStoreChanged = (room : LiveAudienceRoomState, eventName : string, res : string) : void => {
     try {
-        if (eventName === "audienceList") {
-            audienceList.value = safeJsonParse<LiveUserInfoParam[]>(res, []);
+        if (eventName === "userProfiles") {
+            applyUserProfiles(res);
+        } else if (eventName === "audienceList") {
+            room.audienceList.value = parseUserList(res).slice(0, room.audienceListWindowSize.value);
+            room.audienceListCursor.value = 0;
+            room.hasMoreAudience.value = true;
+        } else if (eventName === "audienceListDelta") {
+            applyAudienceListDelta(room, parseAudienceListDelta(res));
         } else if (eventName === "audienceCount") {
-            audienceCount.value = safeJsonParse<number>(res, 0);
+            room.audienceCount.value = safeJsonParse<number>(res, 0);
         }
     } catch (error) {
         console.error("onLiveAudienceStoreChanged error:", error);
     }
 };
 
-function bindEvent(liveID : string) : void {
-    getRTCRoomEngineManager().on("liveAudienceStoreChanged", onLiveAudienceStoreChanged, liveID);
-}
+/**
+ * Promise 版本的操作方法：参数同回调版本（不含 success/fail），第二个参数可传 { timeout, signal }，
+ * 失败、超时或取消时以 UTSCallError 拒绝
+ * @memberof module:LiveAudienceState
+ * @example
+ * import { useLiveAudienceState } from '@/uni_modules/tuikit-atomic-x/state/LiveAudienceState';
+ * const { fetchAudienceListAsync } = useLiveAudienceState('your_live_id');
+ * await fetchAudienceListAsync({ liveID: 'your_live_id' });
+ */
+const fetchAudienceListAsync = promisifyUTSCall("fetchAudienceList", fetchAudienceList);
+const fetchAudienceListPageAsync = promisifyUTSCall("fetchAudienceListPage", fetchAudienceListPage);
+const setAdministratorAsync = promisifyUTSCall("setAdministrator", setAdministrator);
+const revokeAdministratorAsync = promisifyUTSCall("revokeAdministrator", revokeAdministrator);
+const kickUserOutOfRoomAsync = promisifyUTSCall("kickUserOutOfRoom", kickUserOutOfRoom);
+const disableSendMessageAsync = promisifyUTSCall("disableSendMessage", disableSendMessage);
 
 export function useLiveAudienceState(liveID : string) {
-    bindEvent(liveID);
+    const room = useRoomState(liveID, "liveAudienceStoreChanged", createLiveAudienceRoomState,
+        onLiveAudienceStoreChanged, room => room.audienceList.value);
     return {
-        audienceList,           // 直播间观众列表
-        audienceCount,          // 直播间观众数量
+        audienceList: room.audienceList, // 直播间观众列表（窗口）
+        audienceCount: room.audienceCount, // 直播间观众数量
+        audienceListCursor: room.audienceListCursor, // 观众列表分页游标
+        hasMoreAudience: room.hasMoreAudience, // 是否还有未拉取的观众
 
         fetchAudienceList,      // 获取观众列表
+        fetchAudienceListPage,  // 分页拉取观众列表
+        setAudienceListWindowSize, // 设置观众名单窗口大小
         setAdministrator,       // 设置管理员
         revokeAdministrator,    // 撤销管理员权限
         kickUserOutOfRoom,      // 将用户踢出直播间
@@ -158,6 +362,13 @@ export function useLiveAudienceState(liveID : string) {
 
         addAudienceListener,    // 添加观众事件监听
         removeAudienceListener, // 移除观众事件监听
+
+        fetchAudienceListAsync, // 获取观众列表（Promise）
+        fetchAudienceListPageAsync, // 分页拉取观众列表（Promise）
+        setAdministratorAsync,  // 设置管理员（Promise）
+        revokeAdministratorAsync, // 撤销管理员权限（Promise）
+        kickUserOutOfRoomAsync, // 将用户踢出直播间（Promise）
+        disableSendMessageAsync, // 禁用用户发送消息（Promise）
     };
 }
 
@@ -2,26 +2,64 @@
  * 直播列表状态管理
  * @module LiveListState
  */
-import { ref } from "vue";
+import { ref, Ref, getCurrentInstance, onUnmounted } from "vue";
 import {
     LiveInfoParam, FetchLiveListOptions, CreateLiveOptions, JoinLiveOptions, LeaveLiveOptions, EndLiveOptions, UpdateLiveInfoOptions, CallExperimentalAPIOptions, ILiveListener,
 } from "@/uni_modules/tuikit-atomic-x";
-import { getRTCRoomEngineManager } from "./rtcRoomEngine";
+import { bindStoreEvent, getRTCRoomEngineManager } from "./rtcRoomEngine";
 import { callUTSFunction, safeJsonParse } from "../utils/utsUtils";
+import { promisifyUTSCall } from "../utils/asyncCall";
+import { traceCallback, clearFirstMarks } from "../utils/tracing";
+import { WireSchema, parseWireList } from "../utils/wireCodec";
+import { readSessionSnapshot, writeSessionSnapshot } from "../utils/sessionSnapshot";
+
+/**
+ * 直播列表首页快照；isProjected 为 true 时列表只含投影字段，不用于初始化完整字段的 liveList
+ */
+type LiveListSnapshot = {
+    liveList : LiveInfoParam[];
+    cursor : string;
+    isProjected ?: boolean;
+};
+
+const liveListSnapshot = readSessionSnapshot<LiveListSnapshot>("liveList");
+
+/**
+ * liveList 是否仍为启动时读取的快照：首页请求完成或 store 下发非空列表后置为 false
+ */
+let isLiveListFromSnapshot = !!liveListSnapshot?.liveList.length;
+
+/**
+ * store 最近一次下发的值，包括首页请求完成前因快照未应用的空列表；首页请求完成后以此为准并写入快照
+ */
+const lastStoreEmission : { liveList ?: LiveInfoParam[], liveListProjected ?: LiveInfoParam[], cursor ?: string } = {};
+
+/**
+ * 首页请求发出后 store 是否已下发 liveList；请求完成时尚未下发则快照推迟到下一次下发时写入
+ */
+let hasLiveListSinceFetch = false;
+let isSnapshotWritePending = false;
 
 /**
  * 直播列表数据
  * @type {Ref<LiveInfoParam[]>}
  * @memberof module:LiveListState
  */
-const liveList = ref<LiveInfoParam[]>([]);
+const liveList = ref<LiveInfoParam[]>(liveListSnapshot && !liveListSnapshot.isProjected ? liveListSnapshot.liveList : []);
+
+/**
+ * 按字段投影的直播列表，只返回给通过 liveListFields 指定字段的订阅方，其中的 LiveInfo 只包含各订阅方所需字段的并集
+ * @type {Ref<LiveInfoParam[]>}
+ * @memberof module:LiveListState
+ */
+const projectedLiveList = ref<LiveInfoParam[]>(liveListSnapshot?.liveList ?? []);
 
 /**
  * 直播列表游标，用于分页加载
  * @type {Ref<string>}
  * @memberof module:LiveListState
  */
-const liveListCursor = ref<string>("");
+const liveListCursor = ref<string>(liveListSnapshot?.cursor ?? "");
 
 /**
  * 当前直播信息
@@ -41,7 +79,49 @@ const currentLive = ref<LiveInfoParam | null>(null);
  * fetchLiveList({ cursor: "", count: 20 });
  */
 function fetchLiveList(params : FetchLiveListOptions) : void {
-    callUTSFunction("fetchLiveList", params);
+    if (params.cursor) {
+        callUTSFunction("fetchLiveList", params);
+        return;
+    }
+    // 首页请求完成后以 store 数据为准（包括之前被忽略的空列表），并用 store 下发的数据更新首页快照
+    hasLiveListSinceFetch = false;
+    callUTSFunction("fetchLiveList", {
+        ...params,
+        success: () => {
+            if (isLiveListFromSnapshot) {
+                isLiveListFromSnapshot = false;
+                if (lastStoreEmission.liveList) {
+                    liveList.value = lastStoreEmission.liveList;
+                }
+                if (lastStoreEmission.liveListProjected) {
+                    projectedLiveList.value = lastStoreEmission.liveListProjected;
+                }
+                if (lastStoreEmission.cursor !== undefined) {
+                    liveListCursor.value = lastStoreEmission.cursor;
+                }
+            }
+            // store 的下发在编码线程上完成，可能晚于请求回调到达，此时快照等下一次下发再写
+            if (hasLiveListSinceFetch) {
+                writeLiveListSnapshot();
+            } else {
+                isSnapshotWritePending = true;
+            }
+            params.success?.();
+        },
+    });
+}
+
+/**
+ * 用 store 最近一次下发的首页数据写入快照，只有投影列表时标记为投影快照
+ */
+function writeLiveListSnapshot() : void {
+    isSnapshotWritePending = false;
+    const isProjected = !lastStoreEmission.liveList;
+    writeSessionSnapshot<LiveListSnapshot>("liveList", {
+        liveList: lastStoreEmission.liveList ?? lastStoreEmission.liveListProjected ?? [],
+        cursor: lastStoreEmission.cursor ?? "",
+        isProjected,
+    });
 }
 
 /**
@@ -55,7 +135,9 @@ function fetchLiveList(params : FetchLiveListOptions) : void {
  * createLive({ title: 'my live', coverUrl: 'https://example.com/cover.jpg'});
  */
 function createLive(params : CreateLiveOptions) : void {
-    callUTSFunction("createLive", params);
+    const liveID = params.liveInfo?.liveID ?? "";
+    clearFirstMarks(liveID);
+    callUTSFunction("createLive", traceCallback("createLive", liveID, params));
 }
 
 /**
@@ -69,7 +151,8 @@ function createLive(params : CreateLiveOptions) : void {
  * joinLive({ liveID: 'host_live_id' });
  */
 function joinLive(params : JoinLiveOptions) : void {
-    callUTSFunction("joinLive", params);
+    clearFirstMarks(params.liveID);
+    callUTSFunction("joinLive", traceCallback("joinLive", params.liveID, params));
 }
 
 /**
@@ -163,11 +246,25 @@ function removeLiveListListener(eventName : string, listener : ILiveListener) :
 
 const onLiveStoreChanged = (eventName : string, res : string) : void => {
     try {
-        if (eventName === "liveList") {
-            const data = safeJsonParse<LiveInfoParam[]>(res, []);
-            liveList.value = data;
+        if (eventName === "liveList" || eventName === "liveListProjected") {
+            const data = parseWireList<LiveInfoParam>(res, WireSchema.liveInfo);
+            lastStoreEmission[eventName] = data;
+            hasLiveListSinceFetch = true;
+            if (data.length === 0 && isLiveListFromSnapshot) {
+                // 首页请求完成前 store 的空列表不覆盖快照，请求完成时再应用
+                return;
+            }
+            isLiveListFromSnapshot = false;
+            (eventName === "liveList" ? liveList : projectedLiveList).value = data;
+            if (isSnapshotWritePending) {
+                writeLiveListSnapshot();
+            }
         } else if (eventName === "liveListCursor") {
             const data = safeJsonParse<string>(res, "");
+            lastStoreEmission.cursor = data;
+            if (!data && isLiveListFromSnapshot) {
+                return;
+            }
             liveListCursor.value = data;
         } else if (eventName === "currentLive") {
             const data = safeJsonParse<LiveInfoParam | null>(res, null);
@@ -179,14 +276,133 @@ const onLiveStoreChanged = (eventName : string, res : string) : void => {
 };
 
 function bindEvent() : void {
-    getRTCRoomEngineManager().on("liveStoreChanged", onLiveStoreChanged, "");
+    bindStoreEvent("liveStoreChanged", onLiveStoreChanged, "");
+}
+
+/**
+ * useLiveListState 参数
+ * @param {string[]} liveListFields - liveList 中需要的 LiveInfo 字段，native 侧只转换并下发这些字段；不传表示读取 liveList 时需要全部字段
+ */
+export type LiveListStateOptions = {
+    liveListFields ?: string[];
+};
+
+/**
+ * 订阅方的字段需求，key 为组件 uid，null 表示需要全部字段；组件外（模块作用域）的订阅无法撤销，使用固定 key。
+ * 未指定字段的订阅方只在读取 liveList 时登记，只使用操作方法、currentLive 或 liveListCursor 的订阅方不登记
+ */
+const liveListProjections = new Map<number, string[] | null>();
+const UNSCOPED_FULL_LIST = -1;
+const UNSCOPED_PROJECTION = -2;
+let appliedLiveListProjection = "*";
+
+/**
+ * 合并所有订阅方的字段需求并下发到 native：有指定字段的订阅方时下发其并集（liveID 始终保留）到 liveListProjected，
+ * 只有存在需要全部字段的订阅方时才下发完整的 liveList；没有任何需求时只下发 liveID 投影
+ */
+function updateLiveListProjection() : void {
+    let fields : Set<string> | null = null;
+    let includeFullList = false;
+    for (const projection of liveListProjections.values()) {
+        if (!projection) {
+            includeFullList = true;
+            continue;
+        }
+        fields = fields ?? new Set(["liveID"]);
+        projection.forEach(field => fields!.add(field));
+    }
+    if (!includeFullList && !fields) {
+        fields = new Set(["liveID"]);
+    }
+    const key = `${includeFullList ? "*" : ""}|${fields ? Array.from(fields).sort().join(",") : ""}`;
+    if (key === appliedLiveListProjection) {
+        return;
+    }
+    appliedLiveListProjection = key;
+    callUTSFunction("setLiveInfoProjection", { fields: fields ? Array.from(fields) : [], includeFullList });
 }
 
-export function useLiveListState() {
+/**
+ * 登记字段需求：指定字段的订阅方立即登记，未指定字段的订阅方在第一次读取 liveList 时登记需要全部字段。
+ * 组件内的登记在组件卸载时自动撤销，组件外的登记一直有效
+ * @returns {() => Ref<LiveInfoParam[]>} 读取该订阅方 liveList 的函数：指定字段时为 projectedLiveList，否则为完整的 liveList
+ */
+function registerLiveListProjection(options ?: LiveListStateOptions | string) : () => Ref<LiveInfoParam[]> {
+    const fields = typeof options === "object" && options?.liveListFields ? options.liveListFields : null;
+    const instance = getCurrentInstance();
+    let isUnmounted = false;
+    const register = () : void => {
+        if (isUnmounted) {
+            return;
+        }
+        if (instance) {
+            liveListProjections.set(instance.uid, fields);
+        } else if (fields) {
+            const merged = new Set([...(liveListProjections.get(UNSCOPED_PROJECTION) ?? []), ...fields]);
+            liveListProjections.set(UNSCOPED_PROJECTION, Array.from(merged));
+        } else {
+            liveListProjections.set(UNSCOPED_FULL_LIST, null);
+        }
+        updateLiveListProjection();
+    };
+    if (instance) {
+        const uid = instance.uid;
+        onUnmounted(() => {
+            isUnmounted = true;
+            if (liveListProjections.delete(uid)) {
+                updateLiveListProjection();
+            }
+        });
+    }
+    if (fields) {
+        register();
+        return () => projectedLiveList;
+    }
+    // native 默认下发完整列表，尚无需求时先按当前登记收窄
+    updateLiveListProjection();
+    let isRegistered = false;
+    return () => {
+        if (!isRegistered) {
+            isRegistered = true;
+            register();
+        }
+        return liveList;
+    };
+}
+
+/**
+ * 直播列表状态
+ * @param {LiveListStateOptions} [options] - 可选，通过 liveListFields 指定 liveList 需要的字段
+ * @example
+ * import { useLiveListState } from '@/uni_modules/tuikit-atomic-x/state/LiveListState';
+ * const { liveList } = useLiveListState({ liveListFields: ['liveID', 'liveName', 'coverURL'] });
+ */
+/**
+ * Promise 版本的操作方法：参数同回调版本（不含 success/fail），第二个参数可传 { timeout, signal }，
+ * 失败、超时或取消时以 UTSCallError 拒绝
+ * @memberof module:LiveListState
+ * @example
+ * import { useLiveListState } from '@/uni_modules/tuikit-atomic-x/state/LiveListState';
+ * const { joinLiveAsync } = useLiveListState();
+ * await joinLiveAsync({ liveID: 'your_live_id' }, { timeout: 5000 });
+ */
+const fetchLiveListAsync = promisifyUTSCall("fetchLiveList", fetchLiveList);
+const createLiveAsync = promisifyUTSCall("createLive", createLive);
+const joinLiveAsync = promisifyUTSCall("joinLive", joinLive);
+const leaveLiveAsync = promisifyUTSCall("leaveLive", leaveLive);
+const endLiveAsync = promisifyUTSCall("endLive", endLive);
+const updateLiveInfoAsync = promisifyUTSCall("updateLiveInfo", updateLiveInfo);
+
+export function useLiveListState(options ?: LiveListStateOptions | string) {
     bindEvent();
+    const readLiveList = registerLiveListProjection(options);
 
     return {
-        liveList,               // 直播列表数据
+        // 直播列表数据；指定 liveListFields 时为只含所需字段的 projectedLiveList，其他订阅方得到完整字段。
+        // 读取时才向 native 登记需要完整列表，解构时不取 liveList 的订阅方不会让 native 编码完整列表
+        get liveList() {
+            return readLiveList();
+        },
         liveListCursor,         // 直播列表分页游标
         currentLive,            // 当前直播信息
 
@@ -199,6 +415,13 @@ export function useLiveListState() {
         callExperimentalAPI,    // 调用实验性API
         addLiveListListener,    // 添加事件监听
         removeLiveListListener, // 移除事件监听
+
+        fetchLiveListAsync,     // 获取直播列表（Promise）
+        createLiveAsync,        // 创建直播（Promise）
+        joinLiveAsync,          // 加入直播（Promise）
+        leaveLiveAsync,         // 离开直播（Promise）
+        endLiveAsync,           // 结束直播（Promise）
+        updateLiveInfoAsync,    // 更新直播信息（Promise）
     };
 }
 
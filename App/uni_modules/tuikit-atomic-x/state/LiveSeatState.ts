@@ -2,14 +2,18 @@
  * 直播间座位状态管理
  * @module LiveSeatState
  */
-import { ref } from "vue";
+import { ref, Ref } from "vue";
 import {
     TakeSeatOptions, LeaveSeatOptions, MuteMicrophoneOptions, UnmuteMicrophoneOptions, KickUserOutOfSeatOptions,
     MoveUserToSeatOptions, UnlockSeatOptions, SeatUserInfoParam, LockSeatOptions,
     OpenRemoteCameraOptions, CloseRemoteCameraOptions, OpenRemoteMicrophoneOptions, CloseRemoteMicrophoneOptions, ILiveListener,
 } from "@/uni_modules/tuikit-atomic-x";
-import { getRTCRoomEngineManager } from "./rtcRoomEngine";
+import { getRTCRoomEngineManager, registerReplayCompactor } from "./rtcRoomEngine";
+import { useRoomState } from "./roomState";
 import { callUTSFunction, safeJsonParse } from "../utils/utsUtils";
+import { promisifyUTSCall } from "../utils/asyncCall";
+import { traceCallback } from "../utils/tracing";
+import { WireSchema, parseWireList, parseWireMap } from "../utils/wireCodec";
 
 /**
  * 区域信息参数类型定义
@@ -60,25 +64,34 @@ export type SeatInfo = {
 }
 
 /**
- * 座位列表
- * @type {Ref<SeatInfo[]>}
+ * 座位增量补丁类型定义，仅包含发生变化的字段
+ * @typedef {Object} SeatInfoPatch
+ * @property {number} index 座位索引
  * @memberof module:LiveSeatState
  */
-const seatList = ref<SeatInfo[]>([]);
+type SeatInfoPatch = { index : number } & Record<string, any>;
 
 /**
- * 画布信息
- * @type {Ref<LiveCanvasParams | null>}
+ * 单个直播间的座位状态
+ * @typedef {Object} LiveSeatRoomState
+ * @property {Ref<SeatInfo[]>} seatList - 座位列表
+ * @property {Ref<LiveCanvasParams | null>} canvas - 画布信息
+ * @property {Ref<Map<string, number> | null>} speakingUsers - 正在说话的用户列表
  * @memberof module:LiveSeatState
  */
-const canvas = ref<LiveCanvasParams | null>(null);
+type LiveSeatRoomState = {
+    seatList : Ref<SeatInfo[]>;
+    canvas : Ref<LiveCanvasParams | null>;
+    speakingUsers : Ref<Map<string, number> | null>;
+};
 
-/**
- * 正在说话的用户列表
- * @type {Ref<Map<string, number> | null>}
- * @memberof module:LiveSeatState
- */
-const speakingUsers = ref<Map<string, number> | null>(null);
+function createLiveSeatRoomState() : LiveSeatRoomState {
+    return {
+        seatList: ref<SeatInfo[]>([]),
+        canvas: ref<LiveCanvasParams | null>(null),
+        speakingUsers: ref<Map<string, number> | null>(null),
+    };
+}
 
 /**
  * 用户上麦
@@ -95,7 +108,7 @@ const speakingUsers = ref<Map<string, number> | null>(null);
  * });
  */
 function takeSeat(params : TakeSeatOptions) : void {
-    callUTSFunction("takeSeat", params);
+    callUTSFunction("takeSeat", traceCallback("takeSeat", params.liveID, params));
 }
 
 /**
@@ -328,32 +341,99 @@ function removeLiveSeatEventListener(liveID : string, eventName : string, listen
     getRTCRoomEngineManager().removeLiveSeatEventListener(liveID, eventName, listener);
 }
 
-const onLiveSeatStoreChanged = (eventName : string, res : string) : void => {
+/**
+ * 设置 speakingUsers 的最大下发频率，窗口内只保留最新的音量数据，默认 10 次/秒
+ * @param {number} maxRate - 每秒最多下发次数，小于等于 0 表示不限频
+ * @returns {void}
+ * @memberof module:LiveSeatState
+ * @example
+ * import { useLiveSeatState } from '@/uni_modules/tuikit-atomic-x/state/LiveSeatState';
+ * const { setSpeakingUsersRate } = useLiveSeatState('your_live_id');
+ * setSpeakingUsersRate(5);
+ */
+function setSpeakingUsersRate(maxRate : number) : void {
+    callUTSFunction("setStoreEventRate", { store: "LiveSeat", key: "speakingUsers", maxRate });
+}
+
+/**
+ * 将补丁字段逐层合并到目标对象，保持响应式对象引用不变
+ */
+function mergePatch(target : Record<string, any>, patch : Record<string, any>) : void {
+    Object.keys(patch).forEach((key) => {
+        const value = patch[key];
+        const current = target[key];
+        if (value && typeof value === "object" && !Array.isArray(value)
+            && current && typeof current === "object" && !Array.isArray(current)) {
+            mergePatch(current, value);
+        } else {
+            target[key] = value;
+        }
+    });
+}
+
+/**
+ * 按座位 index 将增量补丁原地应用到座位列表（seatList 或回放快照）
+ */
+function applySeatListPatch(seatList : SeatInfo[], patches : SeatInfoPatch[]) : SeatInfo[] {
+    patches.forEach((patch) => {
+        const seat = seatList.find(item => item.index === patch.index);
+        if (seat) {
+            mergePatch(seat, patch);
+        }
+    });
+    return seatList;
+}
+
+registerReplayCompactor("seatList", {
+    decode: (res) => parseWireList<SeatInfo>(res, WireSchema.seatInfo),
+    apply: (list, deltaKey, res) => applySeatListPatch(list, safeJsonParse<SeatInfoPatch[]>(res, [])),
+});
+
+const onLiveSeatStoreChanged = (room : LiveSeatRoomState, eventName : string, res : string) : void => {
     try {
         if (eventName === "seatList") {
-            seatList.value = safeJsonParse<SeatInfo[]>(res, []);
+            room.seatList.value = parseWireList<SeatInfo>(res, WireSchema.seatInfo);
+        } else if (eventName === "seatListPatch") {
+            applySeatListPatch(room.seatList.value, safeJsonParse<SeatInfoPatch[]>(res, []));
         } else if (eventName === "canvas") {
-            canvas.value = safeJsonParse<LiveCanvasParams | null>(res, null);
+            room.canvas.value = safeJsonParse<LiveCanvasParams | null>(res, null);
         } else if (eventName === "speakingUsers") {
-            speakingUsers.value = safeJsonParse<Map<string, number> | null>(res, null);
+            room.speakingUsers.value = parseWireMap<Map<string, number> | null>(res, null);
         }
     } catch (error) {
         console.error("onLiveSeatStoreChanged error:", error);
     }
 };
 
-
-function bindEvent(liveID : string) : void {
-    getRTCRoomEngineManager().on("liveSeatStoreChanged", onLiveSeatStoreChanged, liveID);
-}
+/**
+ * Promise 版本的操作方法：参数同回调版本（不含 success/fail），第二个参数可传 { timeout, signal }，
+ * 失败、超时或取消时以 UTSCallError 拒绝
+ * @memberof module:LiveSeatState
+ * @example
+ * import { useLiveSeatState } from '@/uni_modules/tuikit-atomic-x/state/LiveSeatState';
+ * const { takeSeatAsync } = useLiveSeatState('your_live_id');
+ * await takeSeatAsync({ liveID: 'your_live_id', seatIndex: 1 });
+ */
+const takeSeatAsync = promisifyUTSCall("takeSeat", takeSeat);
+const leaveSeatAsync = promisifyUTSCall("leaveSeat", leaveSeat);
+const unmuteMicrophoneAsync = promisifyUTSCall("unmuteMicrophone", unmuteMicrophone);
+const kickUserOutOfSeatAsync = promisifyUTSCall("kickUserOutOfSeat", kickUserOutOfSeat);
+const moveUserToSeatAsync = promisifyUTSCall("moveUserToSeat", moveUserToSeat);
+const lockSeatAsync = promisifyUTSCall("lockSeat", lockSeat);
+const unlockSeatAsync = promisifyUTSCall("unlockSeat", unlockSeat);
+const openRemoteCameraAsync = promisifyUTSCall("openRemoteCamera", openRemoteCamera);
+const closeRemoteCameraAsync = promisifyUTSCall("closeRemoteCamera", closeRemoteCamera);
+const openRemoteMicrophoneAsync = promisifyUTSCall("openRemoteMicrophone", openRemoteMicrophone);
+const closeRemoteMicrophoneAsync = promisifyUTSCall("closeRemoteMicrophone", closeRemoteMicrophone);
 
 export function useLiveSeatState(liveID : string) {
-    bindEvent(liveID);
+    const room = useRoomState(liveID, "liveSeatStoreChanged", createLiveSeatRoomState, onLiveSeatStoreChanged,
+        room => room.seatList.value);
     return {
         // 状态变量
-        seatList,                // 座位列表
-        canvas,                  // 画布信息
-        speakingUsers,           // 正在说话的用户列表
+        seatList: room.seatList, // 座位列表
+        canvas: room.canvas,     // 画布信息
+        speakingUsers: room.speakingUsers, // 正在说话的用户列表
 
         // 座位操作方法
         takeSeat,                // 用户上麦
@@ -368,10 +448,23 @@ export function useLiveSeatState(liveID : string) {
         closeRemoteCamera,       // 关闭远程摄像头
         openRemoteMicrophone,    // 开启远程麦克风
         closeRemoteMicrophone,   // 关闭远程麦克风
+        setSpeakingUsersRate,    // 设置说话音量下发频率
 
         // 事件监听方法
         addLiveSeatEventListener,    // 添加座位事件监听
         removeLiveSeatEventListener, // 移除座位事件监听
+
+        takeSeatAsync,           // 用户上麦（Promise）
+        leaveSeatAsync,          // 用户下麦（Promise）
+        unmuteMicrophoneAsync,   // 取消静音麦克风（Promise）
+        kickUserOutOfSeatAsync,  // 将用户踢出座位（Promise）
+        moveUserToSeatAsync,     // 移动用户到指定座位（Promise）
+        lockSeatAsync,           // 锁定座位（Promise）
+        unlockSeatAsync,         // 解锁座位（Promise）
+        openRemoteCameraAsync,   // 开启远程摄像头（Promise）
+        closeRemoteCameraAsync,  // 关闭远程摄像头（Promise）
+        openRemoteMicrophoneAsync, // 开启远程麦克风（Promise）
+        closeRemoteMicrophoneAsync, // 关闭远程麦克风（Promise）
     };
 }
 
@@ -3,7 +3,7 @@
  * @module LiveSummaryState
  */
 import { ref } from "vue";
-import { getRTCRoomEngineManager } from "./rtcRoomEngine";
+import { bindStoreEvent } from "./rtcRoomEngine";
 
 /**
  * 直播间统计信息
@@ -24,7 +24,7 @@ const onLiveSummaryStoreChanged = (eventName: string, res: string): void => {
 };
 
 function bindEvent(liveID: string): void {
-    getRTCRoomEngineManager().on("liveSummaryStoreChanged", onLiveSummaryStoreChanged, '');
+    bindStoreEvent("liveSummaryStoreChanged", onLiveSummaryStoreChanged, '');
 }
 
 export function useLiveSummaryState(liveID: string) {
@@ -4,15 +4,23 @@
  */
 import { ref } from "vue";
 import { UserProfileParam, LoginOptions, LogoutOptions, SetSelfInfoOptions } from "@/uni_modules/tuikit-atomic-x";
-import { getRTCRoomEngineManager } from "./rtcRoomEngine";
+import { bindStoreEvent } from "./rtcRoomEngine";
 import { callUTSFunction, safeJsonParse } from "../utils/utsUtils";
+import { promisifyUTSCall } from "../utils/asyncCall";
+import { traceCallback } from "../utils/tracing";
+import { readSessionSnapshot, writeSessionSnapshot, clearSessionSnapshot } from "../utils/sessionSnapshot";
 
 /**
  * 当前登录用户信息
  * @type {Ref<UserProfileParam>}
  * @memberof module:LoginState
  */
-const loginUserInfo = ref<UserProfileParam>();
+const loginUserInfo = ref<UserProfileParam | undefined>(readSessionSnapshot<UserProfileParam>("loginUserInfo"));
+
+/**
+ * loginUserInfo 是否仍为启动时读取的快照，登录完成或 store 下发有效用户信息后置为 false
+ */
+let isLoginUserInfoFromSnapshot = !!loginUserInfo.value;
 
 /**
  * 当前登录状态
@@ -45,7 +53,36 @@ const sdkAppID = ref<number>();
  * });
  */
 function login(params: LoginOptions): void {
-    callUTSFunction("login", params);
+    if (loginUserInfo.value?.userID && loginUserInfo.value.userID !== params.userID) {
+        // 切换用户，上一个用户的快照全部作废
+        clearSessionSnapshot();
+    }
+    callUTSFunction("login", traceCallback("login", params.userID, {
+        ...params,
+        success: () => {
+            isLoginUserInfoFromSnapshot = false;
+            params.success?.();
+        },
+        fail: (errCode: number, errMsg: string) => {
+            discardLoginSnapshot();
+            if (params.fail) {
+                params.fail(errCode, errMsg);
+            } else {
+                console.error(`[login] Failed:`, { errCode, errMsg });
+            }
+        },
+    }));
+}
+
+/**
+ * 丢弃启动时读取的登录快照（快照恢复的登录失败时调用，下次启动走完整登录）
+ */
+function discardLoginSnapshot(): void {
+    clearSessionSnapshot("loginUserInfo");
+    if (isLoginUserInfoFromSnapshot) {
+        isLoginUserInfoFromSnapshot = false;
+        loginUserInfo.value = undefined;
+    }
 }
 
 /**
@@ -62,6 +99,7 @@ function login(params: LoginOptions): void {
  * });
  */
 function logout(params?: LogoutOptions): void {
+    clearSessionSnapshot();
     callUTSFunction("logout", params || {});
 }
 
@@ -93,7 +131,15 @@ const onLoginStoreChanged = (eventName: string, res: string): void => {
     try {
         if (eventName === "loginUserInfo") {
             const data = safeJsonParse<UserProfileParam>(res, {});
+            if (!data.userID && isLoginUserInfoFromSnapshot) {
+                // 登录完成前 store 下发的空用户信息不覆盖快照
+                return;
+            }
+            isLoginUserInfoFromSnapshot = false;
             loginUserInfo.value = data;
+            if (data.userID) {
+                writeSessionSnapshot("loginUserInfo", data);
+            }
         } else if (eventName === "loginStatus") {
             loginStatus.value = safeJsonParse<string>(res, "");
         }
@@ -103,9 +149,21 @@ const onLoginStoreChanged = (eventName: string, res: string): void => {
 };
 
 function bindEvent(): void {
-    getRTCRoomEngineManager().on("loginStoreChanged", onLoginStoreChanged, '');
+    bindStoreEvent("loginStoreChanged", onLoginStoreChanged, '');
 }
 
+/**
+ * Promise 版本的操作方法：参数同回调版本（不含 success/fail），第二个参数可传 { timeout, signal }，
+ * 失败、超时或取消时以 UTSCallError 拒绝
+ * @memberof module:LoginState
+ * @example
+ * import { useLoginState } from '@/uni_modules/tuikit-atomic-x/state/LoginState';
+ * const { loginAsync } = useLoginState();
+ * await loginAsync({ sdkAppID, userID, userSig });
+ */
+const loginAsync = promisifyUTSCall("login", login);
+const logoutAsync = promisifyUTSCall("logout", logout);
+
 export function useLoginState() {
     bindEvent();
     return {
@@ -117,6 +175,10 @@ export function useLoginState() {
         logout,            // 登出方法
         setSelfInfo,       // 设置用户信息
         getLoginUserInfo,  // 获取登录用户信息
+        discardLoginSnapshot, // 丢弃登录快照
+
+        loginAsync,        // 登录（Promise）
+        logoutAsync,       // 登出（Promise）
     };
 }
 
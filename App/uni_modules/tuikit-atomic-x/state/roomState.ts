@@ -0,0 +1,257 @@
+/**
+ * 直播间作用域状态管理：按 liveID 隔离各 store 的状态容器，支持同时观察当前房间、连线房间与预加载房间
+ * @module RoomState
+ */
+import { getCurrentInstance, onUnmounted } from "vue";
+import { DELTA_BASE_KEYS, StoreListener, subscribeStore } from "./rtcRoomEngine";
+import { markFirst } from "../utils/tracing";
+
+/**
+ * 每个直播间首次收到时记录追踪标记的事件 key -> 标记名；同名标记每个直播间只记录一次，空列表不计
+ */
+const FIRST_MARK_NAMES : Record<string, string> = {
+    seatList: "first seatList",
+    messageListAppend: "first barrage",
+    // 进房时已有的历史弹幕通过全量事件下发，首条弹幕可能不会经过 messageListAppend
+    messageListReset: "first barrage",
+};
+
+/**
+ * JSON 与紧凑格式的空列表
+ */
+function isEmptyList(res : string) : boolean {
+    return res === "[]" || res === "[\"c1\"]";
+}
+
+/**
+ * 单个 store 在某个直播间的状态容器
+ */
+type RoomContainer = {
+    state : object;
+    bytes : Map<string, number>;         // 事件 key -> 估算字节数
+    measuredBytes : Map<string, number>; // 全量事件 key -> 最近一次全量或实测的字节数
+    measure ?: (state : object) => unknown;
+    release : () => void;                // 释放 native 订阅
+};
+
+type RoomEntry = {
+    liveID : string;
+    containers : Map<string, RoomContainer>; // eventName -> 容器
+    bytes : number;
+    lastViewedAt : number;
+    mountCount : number; // 正在使用该房间状态的组件数，大于 0 时不会被淘汰
+    isPinned : boolean;  // 是否在组件外使用过：无法得知何时不再使用，常驻直到 disposeRoomState
+};
+
+/**
+ * 直播间状态内存预算
+ * @typedef {Object} RoomStateBudget
+ * @property {number} [maxRooms] - 最多保留的直播间数量
+ * @property {number} [maxBytes] - 所有直播间状态的估算总字节数上限
+ */
+export type RoomStateBudget = {
+    maxRooms ?: number;
+    maxBytes ?: number;
+};
+
+const budget : Required<RoomStateBudget> = {
+    maxRooms: 4,
+    maxBytes: 8 * 1024 * 1024,
+};
+
+// 增量累加到该体积以下时不实测，避免小列表频繁序列化
+const MIN_REMEASURE_BYTES = 16 * 1024;
+
+const rooms = new Map<string, RoomEntry>();
+let totalBytes = 0;
+let isEvictionScheduled = false;
+
+function getRoomEntry(liveID : string) : RoomEntry {
+    let room = rooms.get(liveID);
+    if (!room) {
+        room = { liveID, containers: new Map(), bytes: 0, lastViewedAt: Date.now(), mountCount: 0, isPinned: false };
+        rooms.set(liveID, room);
+    }
+    return room;
+}
+
+/**
+ * 记录事件数据的估算体积（UTF-16，每字符 2 字节）：全量事件覆盖（清掉之前累加的增量），增量事件（DELTA_BASE_KEYS）累加到其全量事件上。
+ * 列表有长度上限（弹幕总数、观众窗口、座位数），累加值超过上次全量或实测值的 2 倍时序列化当前列表重新实测，
+ * 使估算值不超过实际体积的约 2 倍；实测只在累加量翻倍时发生，摊还开销与增量数据量成正比
+ */
+function trackBytes(room : RoomEntry, container : RoomContainer, key : string, res : string) : void {
+    const baseKey = DELTA_BASE_KEYS[key];
+    const trackedKey = baseKey ?? key;
+    const size = res.length * 2;
+    const previous = container.bytes.get(trackedKey) ?? 0;
+    let next = size;
+    if (!baseKey) {
+        container.measuredBytes.set(key, size);
+    } else {
+        next = previous + size;
+        const measured = container.measuredBytes.get(baseKey) ?? 0;
+        if (container.measure && next > 2 * Math.max(measured, MIN_REMEASURE_BYTES)) {
+            next = (JSON.stringify(container.measure(container.state)) ?? "").length * 2;
+            container.measuredBytes.set(baseKey, next);
+        }
+    }
+    container.bytes.set(trackedKey, next);
+    room.bytes += next - previous;
+    totalBytes += next - previous;
+    if (totalBytes > budget.maxBytes) {
+        scheduleEviction();
+    }
+}
+
+/**
+ * 淘汰放到微任务中执行，避免在某个房间的事件分发过程中释放其订阅
+ */
+function scheduleEviction() : void {
+    if (isEvictionScheduled) {
+        return;
+    }
+    isEvictionScheduled = true;
+    Promise.resolve().then(() => {
+        isEvictionScheduled = false;
+        evictRooms();
+    });
+}
+
+/**
+ * 超出预算时按最近查看时间淘汰未被组件使用、也未在组件外使用的直播间
+ */
+function evictRooms() : void {
+    if (rooms.size <= budget.maxRooms && totalBytes <= budget.maxBytes) {
+        return;
+    }
+    const candidates = Array.from(rooms.values())
+        .filter(room => room.mountCount === 0 && !room.isPinned)
+        .sort((a, b) => a.lastViewedAt - b.lastViewedAt);
+    for (const room of candidates) {
+        if (rooms.size <= budget.maxRooms && totalBytes <= budget.maxBytes) {
+            break;
+        }
+        console.log(`RoomState evict room, liveID: ${room.liveID}, bytes: ${room.bytes}`);
+        disposeRoomState(room.liveID);
+    }
+}
+
+/**
+ * 获取直播间内某个 store 的状态容器，不存在时创建并订阅 native store；
+ * 在组件内调用时该房间在组件卸载前不会被淘汰；在组件外调用时该房间常驻，不参与淘汰，不再使用时需调用 disposeRoomState 释放
+ * @param {string} liveID - 直播间ID
+ * @param {string} eventName - store 事件名，如 barrageStoreChanged
+ * @param {() => T} create - 创建空状态
+ * @param {(state : T, key : string, res : string) => void} onChanged - store 事件处理函数
+ * @param {(state : T) => unknown} [measure] - 返回增量事件所更新的列表，用于实测其体积；不传时增量体积只在全量事件到达时重置
+ * @returns {T} 该直播间的状态
+ */
+export function useRoomState<T extends object>(liveID : string, eventName : string, create : () => T,
+    onChanged : (state : T, key : string, res : string) => void, measure ?: (state : T) => unknown) : T {
+    const room = getRoomEntry(liveID);
+    room.lastViewedAt = Date.now();
+    if (getCurrentInstance()) {
+        room.mountCount++;
+        onUnmounted(() => {
+            room.mountCount--;
+            room.lastViewedAt = Date.now();
+            scheduleEviction();
+        });
+    } else {
+        room.isPinned = true;
+    }
+    let container = room.containers.get(eventName);
+    if (!container) {
+        const state = create();
+        const created : RoomContainer = {
+            state,
+            bytes: new Map(),
+            measuredBytes: new Map(),
+            measure: measure as ((state : object) => unknown) | undefined,
+            release: () => { },
+        };
+        const listener : StoreListener = (key : string, res : string) => {
+            onChanged(state, key, res);
+            // 在事件应用之后统计，实测时得到的是已合并增量、已裁剪的列表
+            trackBytes(room, created, key, res);
+            if (FIRST_MARK_NAMES[key] && !isEmptyList(res)) {
+                markFirst(FIRST_MARK_NAMES[key], liveID);
+            }
+        };
+        room.containers.set(eventName, created);
+        created.release = subscribeStore(eventName, listener, liveID);
+        container = created;
+        scheduleEviction();
+    }
+    return container.state as T;
+}
+
+/**
+ * 获取已创建的直播间状态，不创建容器也不订阅，供按 liveID 调用的操作方法更新状态
+ */
+export function peekRoomState<T extends object>(liveID : string, eventName : string) : T | undefined {
+    return rooms.get(liveID)?.containers.get(eventName)?.state as T | undefined;
+}
+
+/**
+ * 标记直播间被查看（如信息流滑动到该房间），更新其淘汰优先级
+ * @param {string} liveID - 直播间ID
+ * @example
+ * import { viewRoom } from '@/uni_modules/tuikit-atomic-x/state/roomState';
+ * viewRoom('your_live_id');
+ */
+export function viewRoom(liveID : string) : void {
+    const room = rooms.get(liveID);
+    if (room) {
+        room.lastViewedAt = Date.now();
+    }
+}
+
+/**
+ * 释放直播间的全部状态容器并取消对应的 native 订阅；仍在使用这些状态的组件将不再收到更新
+ * @param {string} liveID - 直播间ID
+ * @example
+ * import { disposeRoomState } from '@/uni_modules/tuikit-atomic-x/state/roomState';
+ * disposeRoomState('preloaded_live_id');
+ */
+export function disposeRoomState(liveID : string) : void {
+    const room = rooms.get(liveID);
+    if (!room) {
+        return;
+    }
+    rooms.delete(liveID);
+    totalBytes -= room.bytes;
+    room.containers.forEach(container => container.release());
+    room.containers.clear();
+}
+
+/**
+ * 设置直播间状态内存预算，超出时按最近查看时间淘汰未被组件使用的直播间（组件外使用的直播间常驻，不计入淘汰候选）
+ * @param {RoomStateBudget} options - 内存预算
+ * @example
+ * import { setRoomStateBudget } from '@/uni_modules/tuikit-atomic-x/state/roomState';
+ * setRoomStateBudget({ maxRooms: 6, maxBytes: 4 * 1024 * 1024 });
+ */
+export function setRoomStateBudget(options : RoomStateBudget) : void {
+    if (options.maxRooms !== undefined) {
+        budget.maxRooms = Math.max(1, options.maxRooms);
+    }
+    if (options.maxBytes !== undefined) {
+        budget.maxBytes = Math.max(0, options.maxBytes);
+    }
+    scheduleEviction();
+}
+
+/**
+ * 当前保留的直播间及其估算内存，用于调试内存预算
+ */
+export function getRoomStateStats() : { liveID : string, bytes : number, lastViewedAt : number, mountCount : number, isPinned : boolean }[] {
+    return Array.from(rooms.values()).map(room => ({
+        liveID: room.liveID,
+        bytes: room.bytes,
+        lastViewedAt: room.lastViewedAt,
+        mountCount: room.mountCount,
+        isPinned: room.isPinned,
+    }));
+}
@@ -1,4 +1,6 @@
+import { getCurrentInstance, onUnmounted } from "vue";
 import { RTCRoomEngineManager } from "@/uni_modules/tuikit-atomic-x";
+import { isBridgeMetricsEnabled, beginDispatch, endDispatch } from "../utils/bridgeMetrics";
 
 let instance : RTCRoomEngineManager | null = null;
 
@@ -8,4 +10,236 @@ export function getRTCRoomEngineManager() : RTCRoomEngineManager {
         instance = new RTCRoomEngineManager();
     }
     return instance;
-}
\ No newline at end of file
+}
+
+export type StoreListener = (key : string, res : string) => void;
+
+/**
+ * 增量事件 -> 其全量事件：增量依赖之前的状态，回放给后加入的监听者时需跟在全量之后按顺序回放
+ */
+export const DELTA_BASE_KEYS : Record<string, string> = {
+    messageListAppend: "messageListReset",
+    seatListPatch: "seatList",
+    audienceListDelta: "audienceList",
+};
+
+/**
+ * 用户资料写入全局用户表（utils/userTable），后加入的监听者可直接还原句柄，不需要回放
+ */
+const USER_PROFILES_KEY = "userProfiles";
+
+/**
+ * 增量折叠方式：由对应的 useXxxState 模块注册，把全量数据与其后的增量合并为一份新的全量数据
+ * @property {(res : string) => any[]} decode - 解析全量事件数据（兼容紧凑格式与用户句柄），返回普通对象列表
+ * @property {(list : any[], deltaKey : string, res : string) => any[]} apply - 将一条增量应用到列表，返回新列表
+ */
+export type ReplayCompactor = {
+    decode : (res : string) => any[];
+    apply : (list : any[], deltaKey : string, res : string) => any[];
+};
+
+const compactors = new Map<string, ReplayCompactor>();
+
+/**
+ * 注册全量 key 的增量折叠方式。注册后回放缓存定期把增量折叠进全量快照，
+ * 后加入的监听者只回放快照与少量未折叠的增量，不需要重建 native 订阅
+ * @param {string} baseKey - 全量事件 key，如 messageListReset
+ * @param {ReplayCompactor} compactor - 折叠方式
+ */
+export function registerReplayCompactor(baseKey : string, compactor : ReplayCompactor) : void {
+    compactors.set(baseKey, compactor);
+}
+
+/**
+ * 未折叠的增量达到该条数时折叠进全量快照，解析开销按批摊销
+ */
+const COMPACT_THRESHOLD = 64;
+
+/**
+ * 无法折叠（未注册折叠方式，或全量尚未到达）时每个全量 key 之后最多保留的增量条数，超出后该 key 无法在 JS 侧回放
+ */
+const MAX_REPLAY_DELTAS = 1000;
+
+type StoreSubscription = {
+    eventName : string;
+    liveID : string;
+    listeners : Map<StoreListener, number>;       // 监听函数 -> 引用计数
+    lastValues : Map<string, string>;             // 全量事件 key -> 最近一次的数据（或折叠后的快照），用于回放
+    deltas : Map<string, [string, string][]>;     // 全量事件 key -> 其后到达、尚未折叠的增量 [key, data]
+    truncatedKeys : Set<string>;                  // 增量超过上限、无法回放的全量事件 key
+    dispatch : StoreListener;
+};
+
+/**
+ * 直播间级 store：native 侧按 liveID 分别订阅，多个直播间可同时观察
+ */
+const ROOM_SCOPED_EVENTS = new Set([
+    "liveSeatStoreChanged", "liveAudienceStoreChanged", "giftStoreChanged", "coHostStoreChanged",
+    "coGuestStoreChanged", "barrageStoreChanged", "liveSummaryStoreChanged", "likeStoreChanged",
+]);
+
+/**
+ * 订阅表：直播间级 store 按 (eventName, liveID) 各有一个 native 订阅；
+ * 全局 store 的 native observer 为单例且不区分 liveID，同一 eventName 只有一个订阅，所有监听者共享
+ */
+const subscriptions = new Map<string, StoreSubscription>();
+
+function subscriptionKey(eventName : string, liveID : string) : string {
+    return ROOM_SCOPED_EVENTS.has(eventName) ? `${eventName}:${liveID}` : eventName;
+}
+
+/**
+ * 把全量快照与其后的增量折叠为新的快照（JSON 格式，各 store 的全量解析均兼容），折叠失败时保留原数据
+ */
+function compactReplay(subscription : StoreSubscription, baseKey : string) : boolean {
+    const compactor = compactors.get(baseKey);
+    const base = subscription.lastValues.get(baseKey);
+    const log = subscription.deltas.get(baseKey);
+    if (!compactor || base === undefined || !log) {
+        return false;
+    }
+    try {
+        const list = log.reduce((current, [deltaKey, deltaRes]) => compactor.apply(current, deltaKey, deltaRes),
+            compactor.decode(base));
+        subscription.lastValues.set(baseKey, JSON.stringify(list));
+        subscription.deltas.delete(baseKey);
+        return true;
+    } catch (error) {
+        console.error(`${subscription.eventName} compact ${baseKey} error:`, error);
+        return false;
+    }
+}
+
+/**
+ * 记录回放数据：全量事件覆盖同 key 的旧值并清掉其后的增量；增量按到达顺序追加，
+ * 积累到 COMPACT_THRESHOLD 条时折叠进全量快照
+ */
+function recordReplay(subscription : StoreSubscription, key : string, res : string) : void {
+    const baseKey = DELTA_BASE_KEYS[key];
+    if (baseKey) {
+        if (subscription.truncatedKeys.has(baseKey)) {
+            return;
+        }
+        const log = subscription.deltas.get(baseKey) ?? [];
+        log.push([key, res]);
+        subscription.deltas.set(baseKey, log);
+        if (log.length % COMPACT_THRESHOLD === 0 && compactReplay(subscription, baseKey)) {
+            return;
+        }
+        if (log.length >= MAX_REPLAY_DELTAS) {
+            subscription.truncatedKeys.add(baseKey);
+            subscription.deltas.delete(baseKey);
+        }
+    } else if (key !== USER_PROFILES_KEY) {
+        subscription.lastValues.set(key, res);
+        subscription.deltas.delete(key);
+        subscription.truncatedKeys.delete(key);
+    }
+}
+
+/**
+ * 向后加入的监听者回放当前状态：每个全量值之后紧跟其增量，得到与一直在监听的监听者相同的状态
+ */
+function replayTo(subscription : StoreSubscription, listener : StoreListener) : void {
+    subscription.lastValues.forEach((res, key) => {
+        listener(key, res);
+        subscription.deltas.get(key)?.forEach(([deltaKey, deltaRes]) => listener(deltaKey, deltaRes));
+    });
+    // 全量尚未到达时先到的增量
+    subscription.deltas.forEach((log, baseKey) => {
+        if (!subscription.lastValues.has(baseKey)) {
+            log.forEach(([deltaKey, deltaRes]) => listener(deltaKey, deltaRes));
+        }
+    });
+}
+
+function createSubscription(eventName : string, liveID : string) : StoreSubscription {
+    const subscription : StoreSubscription = {
+        eventName,
+        liveID,
+        listeners: new Map(),
+        lastValues: new Map(),
+        deltas: new Map(),
+        truncatedKeys: new Set(),
+        dispatch: (key : string, res : string) => {
+            if (subscriptions.get(subscriptionKey(eventName, liveID)) !== subscription) {
+                return;
+            }
+            recordReplay(subscription, key, res);
+            const token = isBridgeMetricsEnabled() ? beginDispatch(eventName, key) : null;
+            // 分发期间可能有监听者加入或退出，遍历快照
+            Array.from(subscription.listeners.keys()).forEach((listener) => {
+                try {
+                    listener(key, res);
+                } catch (error) {
+                    console.error(`${eventName} listener error:`, error);
+                }
+            });
+            if (token) {
+                endDispatch(token);
+            }
+        },
+    };
+    return subscription;
+}
+
+/**
+ * 订阅 store 事件：同一 (eventName, liveID)（全局 store 为同一 eventName）只建立一次 native 订阅，多个监听者共享；
+ * 后加入的监听者在 JS 侧回放当前值（增量已折叠进快照）与尚未折叠的增量，不重建 native 订阅。
+ * 只有无法折叠的增量超过回放上限时才由 native 重新同步全量，此时现有监听者也会收到一次全量
+ * @returns {() => void} 释放函数，引用计数归零时取消 native 订阅
+ */
+export function subscribeStore(eventName : string, listener : StoreListener, liveID : string) : () => void {
+    const key = subscriptionKey(eventName, liveID);
+    let subscription = subscriptions.get(key);
+    if (!subscription) {
+        subscription = createSubscription(eventName, liveID);
+        subscriptions.set(key, subscription);
+        subscription.listeners.set(listener, 1);
+        getRTCRoomEngineManager().on(eventName, subscription.dispatch, liveID);
+    } else {
+        const count = subscription.listeners.get(listener) ?? 0;
+        subscription.listeners.set(listener, count + 1);
+        if (count === 0) {
+            if (subscription.truncatedKeys.size > 0) {
+                console.warn(`${eventName} replay truncated, resync from native, keys: ${Array.from(subscription.truncatedKeys)}`);
+                getRTCRoomEngineManager().on(eventName, subscription.dispatch, subscription.liveID);
+            } else {
+                replayTo(subscription, listener);
+            }
+        }
+    }
+    const current = subscription;
+    let released = false;
+    return () => {
+        if (released) {
+            return;
+        }
+        released = true;
+        releaseStore(current, listener);
+    };
+}
+
+function releaseStore(subscription : StoreSubscription, listener : StoreListener) : void {
+    const count = subscription.listeners.get(listener) ?? 0;
+    if (count > 1) {
+        subscription.listeners.set(listener, count - 1);
+        return;
+    }
+    subscription.listeners.delete(listener);
+    const key = subscriptionKey(subscription.eventName, subscription.liveID);
+    if (subscription.listeners.size === 0 && subscriptions.get(key) === subscription) {
+        subscriptions.delete(key);
+        getRTCRoomEngineManager().off(subscription.eventName, subscription.liveID);
+    }
+}
+
+/**
+ * 供 useXxxState 绑定 store 事件：在组件内调用时随组件卸载自动释放，组件外调用视为常驻订阅
+ */
+export function bindStoreEvent(eventName : string, listener : StoreListener, liveID : string) : void {
+    const release = subscribeStore(eventName, listener, liveID);
+    if (getCurrentInstance()) {
+        onUnmounted(release);
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * DualLoginJoin（iOS/Android index.uts）汇合逻辑测试：沙箱与 CI 中没有 UTS 编译器与设备运行时，
+ * 这里从两端 index.uts 中取出 DualLoginJoin 类的源码，去掉 UTS 特有语法与类型后在 Node 中运行，
+ * 命令队列、LoginStore 与 TUIRoomEngine 替换为记录调用的实现。两个 SDK 的结果与 supersede 都经命令队列串行执行，
+ * 结果只取决于到达顺序，因此对每种结果组合穷举全部到达顺序
+ * 运行：node --test test/*.test.mjs
+ */
+import { test } from "node:test";
+import assert from "node:assert/strict";
+import { mkdtempSync, readFileSync, writeFileSync } from "node:fs";
+import { tmpdir } from "node:os";
+import { join } from "node:path";
+import { fileURLToPath, pathToFileURL } from "node:url";
+import { stripTypes } from "./support/loadTs.mjs";
+
+const runtime = {
+    queue: [],
+    calls: [],
+};
+globalThis.dualLoginRuntime = runtime;
+
+const PRELUDE = `
+const runtime = globalThis.dualLoginRuntime;
+const RTC_TAG = "UTS-RTC: ";
+const post = (block) => runtime.queue.push(block);
+const CommandExecutor = { post, shared: { post } };
+const bridgeLogger = { info() {}, warn() {}, error() {} };
+const LoginStore = { shared: { logout: () => runtime.calls.push("logout LoginStore") } };
+const TUIRoomEngine = { logout: () => runtime.calls.push("logout TUIRoomEngine") };
+const JsonUtil = { toCompletionClosure: () => null };
+`;
+
+/**
+ * 取出 DualLoginJoin 类并转换为 JS：去掉具名参数（iOS）、匿名类的 implements/override（Android），
+ * Android 的 function () {} 回调在 UTS 中捕获外层 this，转换为箭头函数
+ */
+function extractJoinClass(platform) {
+    const source = readFileSync(fileURLToPath(new URL(`../utssdk/app-${platform}/index.uts`, import.meta.url)), "utf8");
+    const start = source.indexOf("\nclass DualLoginJoin {");
+    assert.ok(start >= 0, `DualLoginJoin not found in app-${platform}/index.uts`);
+    const end = source.indexOf("\n}\n", start);
+    const body = source.slice(start, end + 3)
+        .replace(/(?<=[(,]\s*)\b\w+ = (?=[(A-Z])/g, "")
+        .replace(/\bfunction \(\) \{/g, "() => {")
+        .replace(/\bclass implements [\w.]+ \{/g, "class {")
+        .replace(/\boverride /g, "")
+        .replace(/^\s+private \w+ : \w+\n/gm, "")
+        .replace(/^(\s+)(?:private|public) /gm, "$1")
+        .replace(/^(\s+)(\w+) : \w+ = /gm, "$1$2 = ");
+    return stripTypes(body);
+}
+
+async function loadJoin(platform) {
+    const file = join(mkdtempSync(join(tmpdir(), "atomicx-test-")), `dualLoginJoin.${platform}.mjs`);
+    writeFileSync(file, `${PRELUDE}${extractJoinClass(platform)}\nexport { DualLoginJoin };\n`);
+    return (await import(pathToFileURL(file).href)).DualLoginJoin;
+}
+
+const joins = { android: await loadJoin("android"), ios: await loadJoin("ios") };
+
+function permutations(items) {
+    if (items.length <= 1) {
+        return [items];
+    }
+    return items.flatMap((item, i) => permutations([...items.slice(0, i), ...items.slice(i + 1)]).map(rest => [item, ...rest]));
+}
+
+/**
+ * 按顺序投递事件后清空命令队列，返回 success/fail 回调与登出调用
+ */
+function run(DualLoginJoin, order) {
+    runtime.queue = [];
+    runtime.calls = [];
+    const join = new DualLoginJoin({
+        success: () => runtime.calls.push("success"),
+        fail: (code) => runtime.calls.push(`fail ${code}`),
+    });
+    for (const event of order) {
+        if (event === "storeOk") join.storeSucceeded();
+        else if (event === "engineOk") join.engineSucceeded();
+        else if (event === "storeFail") join.storeFailed(1, "store");
+        else if (event === "engineFail") join.engineFailed(2, "engine");
+        else if (event === "supersede") post(() => join.supersede());
+    }
+    while (runtime.queue.length > 0) {
+        runtime.queue.shift()();
+    }
+    return runtime.calls;
+}
+
+function post(block) {
+    runtime.queue.push(block);
+}
+
+/**
+ * 期望结果：两者都成功才回调成功；首个失败回调一次失败；已登录的一方在失败与其登录都已发生、且尚未被取代时登出
+ */
+function expected(order) {
+    const at = (event) => order.indexOf(event);
+    const failures = order.filter(event => event.endsWith("Fail"));
+    const supersededAt = at("supersede") < 0 ? Infinity : at("supersede");
+    const calls = [];
+    if (failures.length === 0) {
+        return ["success"];
+    }
+    for (let i = 0; i < order.length; i++) {
+        const event = order[i];
+        if (event === failures[0]) {
+            calls.push(event === "storeFail" ? "fail 1" : "fail 2");
+        }
+        const isSettle = event.endsWith("Ok") || event.endsWith("Fail");
+        if (!isSettle || i < at(failures[0]) || i > supersededAt) {
+            continue;
+        }
+        // 失败之后的每次汇合都回滚此刻已登录的一方，各方只登出一次
+        for (const [ok, name] of [["storeOk", "logout LoginStore"], ["engineOk", "logout TUIRoomEngine"]]) {
+            if (at(ok) >= 0 && at(ok) <= i && !calls.includes(name)) {
+                calls.push(name);
+            }
+        }
+    }
+    return calls;
+}
+
+const SCENARIOS = [
+    ["storeOk", "engineOk"],
+    ["storeOk", "engineFail"],
+    ["storeFail", "engineOk"],
+    ["storeFail", "engineFail"],
+    ["storeOk", "engineFail", "supersede"],
+    ["storeFail", "engineOk", "supersede"],
+    ["storeOk", "engineOk", "supersede"],
+];
+
+for (const platform of Object.keys(joins)) {
+    test(`${platform}: every arrival order settles once and never leaves a half login`, () => {
+        for (const scenario of SCENARIOS) {
+            for (const order of permutations(scenario)) {
+                const calls = run(joins[platform], order);
+                assert.deepEqual(calls, expected(order), order.join(" -> "));
+                assert.equal(calls.filter(call => call === "success" || call.startsWith("fail")).length, 1, order.join(" -> "));
+            }
+        }
+    });
+}
+
+test("iOS and Android settle identically", () => {
+    for (const scenario of SCENARIOS) {
+        for (const order of permutations(scenario)) {
+            assert.deepEqual(run(joins.ios, order), run(joins.android, order), order.join(" -> "));
+        }
+    }
+});
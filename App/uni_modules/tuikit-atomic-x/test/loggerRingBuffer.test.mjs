@@ -0,0 +1,165 @@
+/**
+ * Logger（Android）环形缓冲区测试：沙箱与 CI 中没有 JVM 与 Android 运行时，Logger.kt 依赖 TRTCCloud 与 android.util.Log，
+ * 无法在宿主机上直接运行。这里用 test/support/recordRingBuffer.mjs 中的移植版本（SharedArrayBuffer + Atomics，
+ * 生产者运行在独立的 worker 线程上）验证丢弃计数、序号回绕与多生产者下的顺序，并检查移植所依据的 Logger.kt 关键语句仍然存在。
+ * 单核机器上 worker 线程很少在 offer 中途被抢占，另外穷举两个生产者逐步交错的全部顺序，确定性地覆盖占位竞争
+ * 运行：node --test test/*.test.mjs
+ */
+import { test } from "node:test";
+import assert from "node:assert/strict";
+import { readFileSync } from "node:fs";
+import { fileURLToPath } from "node:url";
+import { Worker } from "node:worker_threads";
+import { RecordRingBuffer, createRingBufferMemory } from "./support/recordRingBuffer.mjs";
+
+const loggerSource = readFileSync(
+    fileURLToPath(new URL("../utssdk/app-android/kotlin/Logger.kt", import.meta.url)), "utf8");
+
+test("the port follows the offer/poll protocol in Logger.kt", () => {
+    for (const statement of [
+        "val diff = sequences.get(index) - position",
+        "if (tail.compareAndSet(position, position + 1)) {",
+        "sequences.set(index, position + 1)",
+        "} else if (diff < 0L) {",
+        "if (sequences.get(index) != head + 1) {",
+        "sequences.set(index, head + capacity)",
+        "if (!buffer.offer(record)) {\n                droppedCount.incrementAndGet()",
+    ]) {
+        assert.ok(loggerSource.includes(statement), `Logger.kt no longer contains: ${statement}`);
+    }
+});
+
+test("a full buffer rejects new records and keeps the oldest ones", () => {
+    const buffer = new RecordRingBuffer(createRingBufferMemory(8));
+    let dropped = 0;
+    for (let n = 0; n < 20; n++) {
+        if (!buffer.offer(0, n)) {
+            dropped++;
+        }
+    }
+    assert.equal(dropped, 12);
+    const polled = [];
+    for (let record = buffer.poll(); record; record = buffer.poll()) {
+        polled.push(record[1]);
+    }
+    assert.deepEqual(polled, [0, 1, 2, 3, 4, 5, 6, 7]);
+    // 消费后槽位重新可用
+    assert.ok(buffer.offer(0, 20));
+    assert.deepEqual(buffer.poll(), [0, 20]);
+    assert.equal(buffer.poll(), null);
+});
+
+test("sequences wrap around the slots many times without losing order", () => {
+    const buffer = new RecordRingBuffer(createRingBufferMemory(4));
+    const polled = [];
+    let n = 0;
+    for (let round = 0; round < 1000; round++) {
+        const batch = round % 5;
+        for (let i = 0; i < batch; i++) {
+            assert.equal(buffer.offer(0, n), i < 4, `round ${round}, offer ${i}`);
+            if (i < 4) {
+                n++;
+            }
+        }
+        for (let record = buffer.poll(); record; record = buffer.poll()) {
+            polled.push(record[1]);
+        }
+    }
+    assert.equal(polled.length, n);
+    assert.deepEqual(polled, Array.from({ length: n }, (_, i) => i));
+});
+
+/**
+ * 穷举各生产者 offer 步骤的全部交错顺序：每种顺序从新的缓冲区重放，结束后取出全部记录检查
+ */
+function exploreInterleavings(capacity, producers, offersPerProducer, check) {
+    let schedules = 0;
+    let choices = [];
+    while (true) {
+        const buffer = new RecordRingBuffer(createRingBufferMemory(capacity));
+        const accepted = [];
+        const tasks = Array.from({ length: producers }, (_, producer) => (function* () {
+            for (let n = 0; n < offersPerProducer; n++) {
+                if (yield* buffer.offerSteps(producer, n)) {
+                    accepted.push([producer, n]);
+                }
+            }
+        })());
+        const branching = [];
+        let running = tasks.slice();
+        while (running.length > 0) {
+            const depth = branching.length;
+            const choice = choices[depth] ?? 0;
+            branching.push(running.length);
+            choices[depth] = choice;
+            if (running[choice].next().done) {
+                running.splice(choice, 1);
+            }
+        }
+        const polled = [];
+        for (let record = buffer.poll(); record; record = buffer.poll()) {
+            polled.push(record);
+        }
+        check(accepted, polled, choices.slice(0, branching.length));
+        schedules++;
+        let depth = branching.length - 1;
+        while (depth >= 0 && choices[depth] + 1 >= branching[depth]) {
+            depth--;
+        }
+        if (depth < 0) {
+            return schedules;
+        }
+        choices = choices.slice(0, depth + 1);
+        choices[depth]++;
+    }
+}
+
+test("every interleaving of two producers keeps each accepted record exactly once", () => {
+    const schedules = exploreInterleavings(2, 2, 2, (accepted, polled, schedule) => {
+        const key = ([producer, n]) => `${producer}:${n}`;
+        assert.deepEqual(polled.map(key).sort(), accepted.map(key).sort(), `schedule ${schedule}`);
+        assert.ok(accepted.length <= 2, `schedule ${schedule}`);
+        for (let producer = 0; producer < 2; producer++) {
+            const order = polled.filter(record => record[0] === producer).map(record => record[1]);
+            assert.deepEqual(order, [...order].sort((a, b) => a - b), `schedule ${schedule}`);
+        }
+    });
+    assert.ok(schedules > 1000, `explored ${schedules} schedules`);
+});
+
+test("concurrent producers keep per-producer order and account for every record", async () => {
+    const producers = 4;
+    const count = 50000;
+    const memory = createRingBufferMemory(64);
+    const control = new SharedArrayBuffer(4 * (2 + producers));
+    const signals = new Int32Array(control);
+    const workers = Array.from({ length: producers }, (_, producer) => new Worker(
+        new URL("./support/ringBufferProducer.mjs", import.meta.url), { workerData: { memory, control, producer, count } }));
+    await Promise.all(workers.map(worker => new Promise(resolve => worker.once("online", resolve))));
+
+    const buffer = new RecordRingBuffer(memory);
+    const next = new Array(producers).fill(-1);
+    let received = 0;
+    Atomics.store(signals, 0, 1);
+    Atomics.notify(signals, 0);
+    while (true) {
+        const isDone = Atomics.load(signals, 1) === producers;
+        const record = buffer.poll();
+        if (record) {
+            const [producer, n] = record;
+            assert.ok(n > next[producer], `producer ${producer}: ${n} after ${next[producer]}`);
+            next[producer] = n;
+            received++;
+        } else if (isDone) {
+            break;
+        }
+    }
+    await Promise.all(workers.map(worker => new Promise(resolve => worker.once("exit", resolve))));
+
+    let dropped = 0;
+    for (let producer = 0; producer < producers; producer++) {
+        dropped += Atomics.load(signals, 2 + producer);
+    }
+    assert.equal(received + dropped, producers * count);
+    assert.ok(received > 0);
+});
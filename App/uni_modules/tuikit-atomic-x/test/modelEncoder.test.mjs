@@ -0,0 +1,211 @@
+/**
+ * Android ModelEncoder 输出形状测试：沙箱与 CI 中没有 JVM，无法直接运行 Kotlin。
+ * 这里从 ModelEncoder.kt 源码读取各 write* 函数的字段顺序与写入方式，与 JS WireSchema 比对；
+ * 再用逐行移植的 BridgeJsonWriter 按这些字段写出 wireFixtures 的数据，校验紧凑格式与 JSON 格式的输出
+ * 运行：node --test test/*.test.mjs
+ */
+import { test } from "node:test";
+import assert from "node:assert/strict";
+import { readFileSync } from "node:fs";
+import { fileURLToPath } from "node:url";
+import { loadTs } from "./support/loadTs.mjs";
+import { paths, utsUtilsStub, encode, makeBarrage, makeSeat, makeLiveInfo } from "./support/wireFixtures.mjs";
+
+const codec = await loadTs(paths.wireCodec, { "./utsUtils": utsUtilsStub });
+const { WireSchema } = codec;
+
+const encoderSource = readFileSync(
+    fileURLToPath(new URL("../utssdk/app-android/kotlin/observer/ModelEncoder.kt", import.meta.url)), "utf8");
+
+/**
+ * 读取 fun BridgeJsonWriter.writeXxx 的字段：[{ key, op }]，op 为 value/stringMap/anyValue 或嵌套的 write* 函数名；
+ * 同一字段有多个分支时（如 writeBarrage 的 sender 句柄）取嵌套模型的写法
+ */
+function readWriters(source) {
+    const writers = {};
+    for (const match of source.matchAll(/^fun BridgeJsonWriter\.(write\w+)\([^\n]*\{\n([\s\S]*?)^\}/gm)) {
+        const fields = [];
+        for (const [, key, op] of match[2].matchAll(/(?:name|field)\("(\w+)"(?:,\s*fields)?\)(?:\.|\s*\{\s*)(\w+)\(/g)) {
+            const existing = fields.find(field => field.key === key);
+            if (!existing) {
+                fields.push({ key, op });
+            } else if (op.startsWith("write")) {
+                existing.op = op;
+            }
+        }
+        writers[match[1]] = fields;
+    }
+    return writers;
+}
+
+const writers = readWriters(encoderSource);
+
+const SCHEMA_WRITERS = {
+    liveUserInfo: "writeLiveUserInfo",
+    seatUserInfo: "writeSeatUserInfo",
+    region: "writeRegion",
+    seatInfo: "writeSeatInfo",
+    barrage: "writeBarrage",
+    liveInfo: "writeLiveInfo",
+};
+
+/**
+ * 把 writer 的字段还原为 WireSchemaDef 形式，嵌套模型展开为对应 writer 的字段
+ */
+function writerSchema(name) {
+    return writers[name].map(({ key, op }) => (op.startsWith("write") ? [key, writerSchema(op)] : key));
+}
+
+/**
+ * BridgeJsonWriter（ModelEncoder.kt）的逐行移植，保持相同的状态机：字段名延迟输出、JSON 格式下省略 null 字段
+ */
+class BridgeJsonWriter {
+    reset(compact) {
+        this.out = "";
+        this.compact = compact;
+        this.needsComma = false;
+        this.pendingName = null;
+        this.compactStack = [];
+        return this;
+    }
+    beginModel() { return this.begin(this.compact ? "[" : "{", this.compact); }
+    endModel() { return this.end(this.compact ? "]" : "}"); }
+    beginMap() { return this.begin("{", false); }
+    endMap() { return this.end("}"); }
+    beginArray() { return this.begin("[", true); }
+    endArray() { return this.end("]"); }
+    name(name) {
+        this.pendingName = name;
+        return this;
+    }
+    value(value) {
+        if (value === null || value === undefined) return this.nullValue();
+        this.writePrefix();
+        this.out += typeof value === "string" ? this.quote(value) : String(value);
+        return this;
+    }
+    nullValue() {
+        if (this.compactStack.length > 0 && !this.compactStack.at(-1)) {
+            this.pendingName = null;
+            return this;
+        }
+        this.writePrefix();
+        this.out += "null";
+        return this;
+    }
+    stringMap(map) {
+        if (map === null || map === undefined) return this.nullValue();
+        this.beginMap();
+        Object.entries(map).forEach(([key, value]) => this.name(key).anyValue(value));
+        return this.endMap();
+    }
+    anyValue(value) {
+        if (Array.isArray(value)) {
+            this.beginArray();
+            value.forEach(item => this.anyValue(item));
+            return this.endArray();
+        }
+        if (value && typeof value === "object") return this.stringMap(value);
+        return this.value(value);
+    }
+    begin(token, compactContainer) {
+        this.writePrefix();
+        this.out += token;
+        this.compactStack.push(compactContainer);
+        this.needsComma = false;
+        return this;
+    }
+    end(token) {
+        this.compactStack.pop();
+        this.out += token;
+        this.needsComma = true;
+        return this;
+    }
+    writePrefix() {
+        if (this.needsComma) this.out += ",";
+        if (this.pendingName !== null && this.compactStack.length > 0 && !this.compactStack.at(-1)) {
+            this.out += this.quote(this.pendingName) + ":";
+        }
+        this.pendingName = null;
+        this.needsComma = true;
+    }
+    quote(value) {
+        let result = "\"";
+        for (const c of value) {
+            if (c === "\"") result += "\\\"";
+            else if (c === "\\") result += "\\\\";
+            else if (c === "\n") result += "\\n";
+            else if (c === "\r") result += "\\r";
+            else if (c === "\t") result += "\\t";
+            else if (c === "\u2028") result += "\\u2028";
+            else if (c === "\u2029") result += "\\u2029";
+            else if (c < " ") result += `\\u${c.charCodeAt(0).toString(16).padStart(4, "0")}`;
+            else result += c;
+        }
+        return result + "\"";
+    }
+}
+
+/**
+ * 按 ModelEncoder.kt 中读取到的字段执行 write* 函数
+ */
+function writeModel(writer, name, model) {
+    if (model === null || model === undefined) return writer.nullValue();
+    writer.beginModel();
+    for (const { key, op } of writers[name]) {
+        writer.name(key);
+        if (op.startsWith("write")) writeModel(writer, op, model[key]);
+        else writer[op](model[key]);
+    }
+    return writer.endModel();
+}
+
+/**
+ * 与 ModelEncoder.encodeList 相同：紧凑格式为 ["c1", header..., row...]，JSON 格式为对象数组
+ */
+function encodeList(items, name, compact, header = []) {
+    const writer = new BridgeJsonWriter().reset(compact).beginArray();
+    if (compact) {
+        writer.value("c1");
+        header.forEach(value => writer.value(value));
+    }
+    items.forEach(item => writeModel(writer, name, item));
+    return writer.endArray().out;
+}
+
+const fixtures = {
+    seatInfo: Array.from({ length: 9 }, (_, i) => makeSeat(i)),
+    barrage: Array.from({ length: 20 }, (_, i) => makeBarrage(i)),
+    liveInfo: Array.from({ length: 10 }, (_, i) => makeLiveInfo(i)),
+};
+
+test("ModelEncoder.kt writes fields in WireSchema order", () => {
+    for (const [schema, writer] of Object.entries(SCHEMA_WRITERS)) {
+        assert.ok(writers[writer], `${writer} not found in ModelEncoder.kt`);
+        assert.deepEqual(writerSchema(writer), WireSchema[schema], `${writer} vs WireSchema.${schema}`);
+    }
+});
+
+test("compact output matches the wire fixtures and decodes back", () => {
+    for (const [schema, items] of Object.entries(fixtures)) {
+        const res = encodeList(items, SCHEMA_WRITERS[schema], true);
+        assert.equal(res, encode(items, WireSchema[schema]), schema);
+        assert.deepEqual(codec.parseWireList(res, WireSchema[schema]), items, schema);
+    }
+    const header = [200];
+    const res = encodeList(fixtures.barrage, "writeBarrage", true, header);
+    assert.equal(res, encode(fixtures.barrage, WireSchema.barrage, header));
+});
+
+test("JSON output omits null fields and escapes strings", () => {
+    for (const [schema, items] of Object.entries(fixtures)) {
+        const res = encodeList(items, SCHEMA_WRITERS[schema], false);
+        assert.deepEqual(JSON.parse(res), items, schema);
+        assert.deepEqual(codec.parseWireList(res, WireSchema[schema]), items, schema);
+    }
+    const barrage = { ...makeBarrage(1), textContent: "引号\" 反斜杠\\ 换行\n 制表\t \u0001 \u2028\u2029", data: null };
+    const res = encodeList([barrage], "writeBarrage", false);
+    const { data, ...expected } = barrage;
+    assert.deepEqual(JSON.parse(res), [expected]);
+    assert.ok(!res.includes("\u2028") && !res.includes("\u2029"));
+});
@@ -0,0 +1,27 @@
+/**
+ * 模块语法检查：state、utils 与礼物组件下的 TS 模块去掉类型后能被 Node 解析（node --check）
+ * 运行：node --test test/*.test.mjs
+ */
+import { test } from "node:test";
+import assert from "node:assert/strict";
+import { readFileSync, readdirSync, writeFileSync, mkdtempSync } from "node:fs";
+import { spawnSync } from "node:child_process";
+import { tmpdir } from "node:os";
+import { join } from "node:path";
+import { fileURLToPath } from "node:url";
+import { stripTypes } from "./support/loadTs.mjs";
+
+const root = fileURLToPath(new URL("../", import.meta.url));
+const dirs = ["state", "utils", "components/GiftPlayer"];
+const out = mkdtempSync(join(tmpdir(), "atomicx-parse-"));
+
+for (const dir of dirs) {
+    for (const name of readdirSync(join(root, dir)).filter((file) => file.endsWith(".ts"))) {
+        test(`${dir}/${name} parses`, () => {
+            const file = join(out, `${dir.replace(/\W/g, "_")}_${name}.mjs`);
+            writeFileSync(file, stripTypes(readFileSync(join(root, dir, name), "utf8")));
+            const result = spawnSync(process.execPath, ["--check", file], { encoding: "utf8" });
+            assert.equal(result.status, 0, result.stderr);
+        });
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * store 订阅回放测试：增量折叠进全量快照后，后加入的监听者得到与常驻监听者相同的状态，且不重建 native 订阅
+ * 运行：node --test test/*.test.mjs
+ */
+import { test } from "node:test";
+import assert from "node:assert/strict";
+import { fileURLToPath } from "node:url";
+import { loadTs } from "./support/loadTs.mjs";
+
+const engine = await loadTs(fileURLToPath(new URL("../state/rtcRoomEngine.ts", import.meta.url)), {
+    "vue": "export const getCurrentInstance = () => null; export const onUnmounted = () => {};",
+    "@/uni_modules/tuikit-atomic-x": `
+        export class RTCRoomEngineManager {
+            on(eventName, callback, liveID) { globalThis.nativeCalls.push(["on", eventName, liveID]); globalThis.nativeCallbacks.set(eventName, callback); }
+            off(eventName, liveID) { globalThis.nativeCalls.push(["off", eventName, liveID]); }
+        }`,
+    "../utils/bridgeMetrics": "export const isBridgeMetricsEnabled = () => false; export const beginDispatch = () => null; export const endDispatch = () => {};",
+});
+
+globalThis.nativeCalls = [];
+globalThis.nativeCallbacks = new Map();
+
+// 与 BarrageState 相同的语义：追加消息并按 total 裁剪头部
+engine.registerReplayCompactor("messageListReset", {
+    decode: (res) => JSON.parse(res),
+    apply: (list, deltaKey, res) => {
+        const delta = JSON.parse(res);
+        list.push(...delta.messages);
+        return list.slice(Math.max(0, list.length - delta.total));
+    },
+});
+
+function collector() {
+    const state = { list: [], events: 0 };
+    state.listener = (key, res) => {
+        state.events++;
+        if (key === "messageListReset") {
+            state.list = JSON.parse(res);
+        } else if (key === "messageListAppend") {
+            const delta = JSON.parse(res);
+            state.list.push(...delta.messages);
+            state.list = state.list.slice(Math.max(0, state.list.length - delta.total));
+        }
+    };
+    return state;
+}
+
+test("late subscribers replay a compacted snapshot without re-subscribing native", () => {
+    const first = collector();
+    const releaseFirst = engine.subscribeStore("barrageStoreChanged", first.listener, "live_1");
+    const dispatch = globalThis.nativeCallbacks.get("barrageStoreChanged");
+    dispatch("messageListReset", JSON.stringify([{ id: 0 }]));
+    for (let i = 1; i <= 5000; i++) {
+        dispatch("messageListAppend", JSON.stringify({ total: 200, messages: [{ id: i }] }));
+    }
+
+    const late = collector();
+    const releaseLate = engine.subscribeStore("barrageStoreChanged", late.listener, "live_1");
+    assert.deepEqual(late.list, first.list);
+    assert.equal(late.list.length, 200);
+    assert.equal(late.list[199].id, 5000);
+    // 快照加上不足一个折叠批次的增量
+    assert.ok(late.events < 64, `replayed ${late.events} events`);
+    assert.deepEqual(globalThis.nativeCalls.filter(call => call[0] === "on"), [["on", "barrageStoreChanged", "live_1"]]);
+
+    releaseLate();
+    releaseFirst();
+    assert.deepEqual(globalThis.nativeCalls.at(-1), ["off", "barrageStoreChanged", "live_1"]);
+});
+
+test("deltas without a registered compactor fall back to a native resync past the cap", () => {
+    globalThis.nativeCalls = [];
+    const first = collector();
+    const releaseFirst = engine.subscribeStore("liveSeatStoreChanged", first.listener, "live_2");
+    const dispatch = globalThis.nativeCallbacks.get("liveSeatStoreChanged");
+    dispatch("seatList", JSON.stringify([{ index: 0 }]));
+    for (let i = 0; i < 1000; i++) {
+        dispatch("seatListPatch", JSON.stringify([{ index: 0, volume: i }]));
+    }
+
+    const late = collector();
+    const releaseLate = engine.subscribeStore("liveSeatStoreChanged", late.listener, "live_2");
+    assert.equal(globalThis.nativeCalls.filter(call => call[0] === "on").length, 2);
+    releaseLate();
+    releaseFirst();
+});
@@ -0,0 +1,289 @@
+/**
+ * 在 Node 中加载 utils 下的 TS 模块：去掉类型标注后写入临时 .mjs 再导入，不依赖 TypeScript 编译器。
+ * 只支持 state、utils 与礼物组件模块用到的语法（type/interface 声明、函数/箭头函数/方法的参数与返回值标注、
+ * 变量与类字段标注、类型参数、as 断言、非空断言、declare），不支持时导入会直接报语法错误
+ */
+import { readFileSync, writeFileSync, mkdtempSync } from "node:fs";
+import { tmpdir } from "node:os";
+import { join } from "node:path";
+import { pathToFileURL } from "node:url";
+
+function skipBalanced(source, start) {
+    const pairs = { "(": ")", "[": "]", "{": "}", "<": ">" };
+    const close = pairs[source[start]];
+    let depth = 0;
+    for (let i = start; i < source.length; i++) {
+        if (source[i] === source[start]) depth++;
+        else if (source[i] === close && !(close === ">" && source[i - 1] === "=") && --depth === 0) return i + 1;
+    }
+    throw new Error(`unbalanced ${source[start]} at ${start}`);
+}
+
+function skipSpaces(source, i) {
+    while (i < source.length && /\s/.test(source[i])) i++;
+    return i;
+}
+
+function skipString(source, start) {
+    for (let i = start + 1; i < source.length; i++) {
+        if (source[i] === "\\") i++;
+        else if (source[i] === source[start]) return i + 1;
+    }
+    throw new Error(`unterminated string at ${start}`);
+}
+
+/**
+ * 跳过一个类型表达式（A | B、'a' | 'b'、{ ... }、T[]、Map<K, V>、(a: A) => B），返回类型之后的位置
+ */
+function skipType(source, i) {
+    i = skipSpaces(source, i);
+    if (source[i] === "|") i++;
+    for (;;) {
+        i = skipSpaces(source, i);
+        if (source[i] === "'" || source[i] === '"') {
+            i = skipString(source, i);
+        } else if ("{[(".includes(source[i])) {
+            const paren = source[i] === "(";
+            i = skipBalanced(source, i);
+            const arrow = skipSpaces(source, i);
+            if (paren && source.startsWith("=>", arrow)) {
+                return skipType(source, arrow + 2);
+            }
+        } else {
+            const word = /^(keyof|typeof|readonly|unique)\s+/.exec(source.slice(i, i + 9));
+            if (word) i += word[0].length;
+            while (i < source.length && /[\w.]/.test(source[i])) i++;
+            if (source[i] === "<") i = skipBalanced(source, i);
+        }
+        while (source[i] === "[") i = skipBalanced(source, i);
+        const next = skipSpaces(source, i);
+        if (source[next] !== "|" && source[next] !== "&") return i;
+        i = next + 1;
+    }
+}
+
+/**
+ * 去掉单个参数的类型标注，保留默认值
+ */
+function stripParam(param) {
+    let depth = 0;
+    for (let i = 0; i < param.length; i++) {
+        const ch = param[i];
+        if ("([{<".includes(ch)) depth++;
+        else if (")]}>".includes(ch) && !(ch === ">" && param[i - 1] === "=")) depth--;
+        else if (ch === ":" && depth === 0) {
+            const end = skipType(param, i + 1);
+            return param.slice(0, i).trimEnd().replace(/\?$/, "") + param.slice(end);
+        }
+        else if (ch === "=" && depth === 0) break;
+    }
+    return param.replace(/^(\s*[\w.]+)\?/, "$1");
+}
+
+function splitTopLevel(text) {
+    const parts = [];
+    let depth = 0;
+    let start = 0;
+    for (let i = 0; i < text.length; i++) {
+        const ch = text[i];
+        if ("([{<".includes(ch)) depth++;
+        else if (")]}>".includes(ch) && !(ch === ">" && text[i - 1] === "=")) depth--;
+        else if (ch === "," && depth === 0) {
+            parts.push(text.slice(start, i));
+            start = i + 1;
+        }
+    }
+    parts.push(text.slice(start));
+    return parts;
+}
+
+/**
+ * 去掉函数声明的参数与返回值类型
+ */
+function stripFunctionSignatures(source) {
+    let out = "";
+    let cursor = 0;
+    const pattern = /\bfunction\s+\w+\s*(?=[<(])/g;
+    let match;
+    while ((match = pattern.exec(source))) {
+        const generic = match.index + match[0].length;
+        const open = source[generic] === "<" ? skipSpaces(source, skipBalanced(source, generic)) : generic;
+        if (source[open] !== "(") continue;
+        const close = skipBalanced(source, open);
+        const params = splitTopLevel(source.slice(open + 1, close - 1)).map(stripParam).join(",");
+        let rest = skipSpaces(source, close);
+        if (source[rest] === ":") {
+            rest = skipType(source, rest + 1);
+        } else {
+            rest = close;
+        }
+        out += source.slice(cursor, generic) + `(${params})`;
+        cursor = rest;
+        pattern.lastIndex = rest;
+    }
+    return out + source.slice(cursor);
+}
+
+/**
+ * 去掉调用与 new 表达式上的类型参数（foo<T>(...)、new Map<K, V>()）
+ */
+function stripTypeArguments(source) {
+    let out = "";
+    let cursor = 0;
+    const pattern = /\w</g;
+    let match;
+    while ((match = pattern.exec(source))) {
+        const open = match.index + 1;
+        let close;
+        try {
+            close = skipBalanced(source, open);
+        } catch (error) {
+            continue;
+        }
+        const inner = source.slice(open + 1, close - 1);
+        if (source[close] !== "(" || /;|&&|\|\||\n\s*\n/.test(inner)) continue;
+        out += source.slice(cursor, open);
+        cursor = close;
+        pattern.lastIndex = close;
+    }
+    return out + source.slice(cursor);
+}
+
+/**
+ * 去掉类方法（含 constructor）的修饰符、参数与返回值类型：行首标识符加参数列表后紧跟 { 的视为方法定义
+ */
+function stripMethodSignatures(source) {
+    let out = "";
+    let cursor = 0;
+    const pattern = /^(\s+)((?:(?:public|private|protected|static|async)\s+)*)(\w+)\s*(?=\()/gm;
+    let match;
+    while ((match = pattern.exec(source))) {
+        if (/^(if|for|while|switch|catch|function|return)$/.test(match[3])) continue;
+        const open = match.index + match[0].length;
+        const close = skipBalanced(source, open);
+        let rest = skipSpaces(source, close);
+        if (source[rest] === ":") rest = skipSpaces(source, skipType(source, rest + 1));
+        if (source[rest] !== "{") continue;
+        const params = splitTopLevel(source.slice(open + 1, close - 1)).map(stripParam).join(",");
+        const modifiers = match[2].includes("async") ? "async " : "";
+        out += source.slice(cursor, match.index) + `${match[1]}${modifiers}${match[3]}(${params}) `;
+        cursor = rest;
+        pattern.lastIndex = rest;
+    }
+    return out + source.slice(cursor);
+}
+
+/**
+ * 去掉箭头函数的参数与返回值类型：括号后（跳过返回值类型）紧跟 => 的视为箭头函数参数列表
+ */
+function stripArrowSignatures(source) {
+    let out = "";
+    let cursor = 0;
+    for (let open = source.indexOf("(", cursor); open >= 0; open = source.indexOf("(", Math.max(open + 1, cursor))) {
+        let close;
+        try {
+            close = skipBalanced(source, open);
+        } catch (error) {
+            continue;
+        }
+        let rest = skipSpaces(source, close);
+        if (source[rest] === ":" && source[rest + 1] !== ":") {
+            rest = skipSpaces(source, skipType(source, rest + 1));
+        }
+        if (!source.startsWith("=>", rest)) continue;
+        const params = splitTopLevel(source.slice(open + 1, close - 1)).map(stripParam).join(",");
+        out += source.slice(cursor, open) + `(${params}) `;
+        cursor = rest;
+    }
+    return out + source.slice(cursor);
+}
+
+/**
+ * 去掉 as 断言（跳过 import/export 中的重命名）
+ */
+function stripAssertions(source) {
+    let out = "";
+    let cursor = 0;
+    const pattern = /\s+as\s+(?=[A-Za-z_{(\['"])/g;
+    let match;
+    while ((match = pattern.exec(source))) {
+        const lineStart = source.lastIndexOf("\n", match.index) + 1;
+        if (/^\s*(import|export)\b/.test(source.slice(lineStart, match.index)) || /^\s*\w+\s*[,}]/.test(source.slice(match.index + match[0].length, match.index + match[0].length + 80)) && /\{[^}]*$/.test(source.slice(lineStart, match.index))) {
+            continue;
+        }
+        const end = skipType(source, match.index + match[0].length);
+        out += source.slice(cursor, match.index);
+        cursor = end;
+        pattern.lastIndex = end;
+    }
+    return out + source.slice(cursor);
+}
+
+/**
+ * 去掉变量声明的类型标注
+ */
+function stripVariableAnnotations(source) {
+    let out = "";
+    let cursor = 0;
+    const pattern = /\b(?:const|let|var)\s+\w+\s*(:)/g;
+    let match;
+    while ((match = pattern.exec(source))) {
+        const colon = match.index + match[0].length - 1;
+        const end = skipType(source, colon + 1);
+        out += source.slice(cursor, colon).trimEnd();
+        cursor = end;
+        pattern.lastIndex = end;
+    }
+    return out + source.slice(cursor);
+}
+
+/**
+ * 去掉 type 别名、interface 声明与 import type
+ */
+function stripTypeDeclarations(source) {
+    let out = "";
+    let cursor = 0;
+    const pattern = /^(?:export\s+)?(?:type\s+\w+\s*(?:<[^=\n]*>)?\s*=|interface\s+\w+[^{\n]*\{|import\s+type\b[^;\n]*;?)/gm;
+    let match;
+    while ((match = pattern.exec(source))) {
+        let end = match.index + match[0].length;
+        if (match[0].endsWith("=")) {
+            end = skipType(source, end);
+        } else if (match[0].endsWith("{")) {
+            end = skipBalanced(source, end - 1);
+        }
+        if (source[skipSpaces(source, end)] === ";") end = skipSpaces(source, end) + 1;
+        out += source.slice(cursor, match.index);
+        cursor = end;
+        pattern.lastIndex = end;
+    }
+    return out + source.slice(cursor);
+}
+
+export function stripTypes(source) {
+    const stripped = stripFunctionSignatures(stripAssertions(stripTypeArguments(stripTypeDeclarations(source))));
+    return stripVariableAnnotations(stripArrowSignatures(stripMethodSignatures(stripped)))
+        .replace(/^declare\s[^\n]*$/gm, "")
+        // 类字段声明：去掉修饰符与类型，无初始值的整行删除
+        .replace(/^(\s+)(?:(?:public|private|protected|readonly|static)\s+)*(\w+)\??\s*:\s*[^=\n;(]+;$/gm, "")
+        .replace(/^(\s+)(?:(?:public|private|protected|readonly)\s+)+(\w+)\??\s*(?::\s*[^=\n;(]+)?=/gm, "$1$2 =")
+        .replace(/([\w)\]])!(?=[.\[)])/g, "$1");
+}
+
+/**
+ * 加载 TS 模块
+ * @param {string} path - TS 文件路径
+ * @param {Record<string, string>} stubs - 相对导入路径 -> 替代的 JS 源码（以 export 声明导出被导入的名字）
+ */
+export async function loadTs(path, stubs = {}) {
+    const dir = mkdtempSync(join(tmpdir(), "atomicx-test-"));
+    let source = readFileSync(path, "utf8");
+    for (const [specifier, stubSource] of Object.entries(stubs)) {
+        const stubFile = join(dir, `${specifier.replace(/\W/g, "_")}.mjs`);
+        writeFileSync(stubFile, stubSource);
+        source = source.split(`"${specifier}"`).join(JSON.stringify(pathToFileURL(stubFile).href));
+    }
+    const file = join(dir, "module.mjs");
+    writeFileSync(file, stripTypes(source));
+    return import(pathToFileURL(file).href);
+}
@@ -0,0 +1,85 @@
+/**
+ * Logger.kt 中 RecordRingBuffer 的移植，供环形缓冲区测试在多个 worker 线程上并发运行：
+ * 槽位序号、tail 与记录都放在 SharedArrayBuffer 中，AtomicLong/AtomicLongArray 的 get/set/compareAndSet
+ * 对应 Atomics.load/store/compareExchange。记录为 [producer, n] 两个整数。修改 Logger.kt 的 offer/poll 时需同步修改此处
+ */
+
+/**
+ * 创建共享内存，capacity 必须为 2 的幂
+ */
+export function createRingBufferMemory(capacity) {
+    const memory = {
+        capacity,
+        sequences: new SharedArrayBuffer(8 * capacity),
+        tail: new SharedArrayBuffer(8),
+        slots: new SharedArrayBuffer(8 * capacity),
+    };
+    const sequences = new BigInt64Array(memory.sequences);
+    for (let i = 0; i < capacity; i++) {
+        Atomics.store(sequences, i, BigInt(i));
+    }
+    return memory;
+}
+
+export class RecordRingBuffer {
+    constructor(memory) {
+        this.capacity = memory.capacity;
+        this.mask = BigInt(memory.capacity - 1);
+        this.sequences = new BigInt64Array(memory.sequences);
+        this.tail = new BigInt64Array(memory.tail);
+        this.slots = new Int32Array(memory.slots);
+        this.head = 0n;
+    }
+
+    /**
+     * 放入记录，缓冲区满时返回 false
+     */
+    offer(producer, n) {
+        const steps = this.offerSteps(producer, n);
+        let step = steps.next();
+        while (!step.done) {
+            step = steps.next();
+        }
+        return step.value;
+    }
+
+    /**
+     * offer 的逐步执行版本：每次访问共享内存后 yield，供测试穷举多个生产者之间的交错顺序
+     */
+    *offerSteps(producer, n) {
+        while (true) {
+            const position = Atomics.load(this.tail, 0);
+            yield;
+            const index = Number(position & this.mask);
+            const diff = Atomics.load(this.sequences, index) - position;
+            yield;
+            if (diff === 0n) {
+                const isClaimed = Atomics.compareExchange(this.tail, 0, position, position + 1n) === position;
+                yield;
+                if (isClaimed) {
+                    Atomics.store(this.slots, 2 * index, producer);
+                    Atomics.store(this.slots, 2 * index + 1, n);
+                    yield;
+                    Atomics.store(this.sequences, index, position + 1n);
+                    return true;
+                }
+            } else if (diff < 0n) {
+                return false;
+            }
+        }
+    }
+
+    /**
+     * 只能在单个消费者线程上调用
+     */
+    poll() {
+        const index = Number(this.head & this.mask);
+        if (Atomics.load(this.sequences, index) !== this.head + 1n) {
+            return null;
+        }
+        const record = [Atomics.load(this.slots, 2 * index), Atomics.load(this.slots, 2 * index + 1)];
+        Atomics.store(this.sequences, index, this.head + BigInt(this.capacity));
+        this.head++;
+        return record;
+    }
+}
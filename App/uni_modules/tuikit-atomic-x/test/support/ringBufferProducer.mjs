@@ -0,0 +1,20 @@
+/**
+ * 环形缓冲区测试的生产者线程：等待开始信号（signals[0]）后按顺序放入 [producer, 0..count)，与 Logger.enqueue 相同，
+ * 满时丢弃并计数；结束时把丢弃数写入 signals[2 + producer]，并累加完成数 signals[1]
+ */
+import { workerData } from "node:worker_threads";
+import { RecordRingBuffer } from "./recordRingBuffer.mjs";
+
+const { memory, control, producer, count } = workerData;
+const buffer = new RecordRingBuffer(memory);
+const signals = new Int32Array(control);
+
+Atomics.wait(signals, 0, 0);
+let dropped = 0;
+for (let n = 0; n < count; n++) {
+    if (!buffer.offer(producer, n)) {
+        dropped++;
+    }
+}
+Atomics.store(signals, 2 + producer, dropped);
+Atomics.add(signals, 1, 1);
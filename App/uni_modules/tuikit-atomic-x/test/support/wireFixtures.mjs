@@ -0,0 +1,121 @@
+/**
+ * 紧凑格式测试与基准共用：读取 native 侧 WireSchema 的字段顺序，按 native 的 pack 规则编码，以及构造事件数据
+ */
+import { readFileSync } from "node:fs";
+import { fileURLToPath } from "node:url";
+
+const root = fileURLToPath(new URL("../../", import.meta.url));
+
+export const paths = {
+    wireCodec: `${root}utils/wireCodec.ts`,
+    kotlinSchema: `${root}utssdk/app-android/kotlin/observer/WireSchema.kt`,
+    swiftSchema: `${root}utssdk/app-ios/swift/WireSchema.swift`,
+};
+
+/**
+ * wireCodec.ts 只从 utsUtils 导入 safeJsonParse 与 callUTSFunction，替换为不依赖 uni 运行时的实现
+ */
+export const utsUtilsStub = `
+export function safeJsonParse(jsonString, defaultValue) {
+    try { return JSON.parse(jsonString); } catch (error) { return defaultValue; }
+}
+export function callUTSFunction() {}
+`;
+
+function parseFieldLists(source, declaration) {
+    const lists = {};
+    let match;
+    while ((match = declaration.exec(source))) {
+        const open = match.index + match[0].length;
+        let depth = 1;
+        let i = open;
+        while (depth > 0) {
+            const ch = source[i++];
+            if (ch === "(" || ch === "[") depth++;
+            else if (ch === ")" || ch === "]") depth--;
+        }
+        const body = source.slice(open, i - 1);
+        lists[match[1]] = [...body.matchAll(/WireField\("(\w+)"(?:,\s*(\w+))?\)/g)].map(([, key, nested]) => ({ key, nested }));
+    }
+    const resolve = (fields) => fields.map(({ key, nested }) => nested ? [key, resolve(lists[nested])] : key);
+    return Object.fromEntries(Object.entries(lists).map(([name, fields]) => [name, resolve(fields)]));
+}
+
+/**
+ * 读取 native 侧 schema，返回与 JS WireSchemaDef 相同形式的字段定义
+ * @returns {{ kotlin: Record<string, any[]>, swift: Record<string, any[]> }}
+ */
+export function readNativeSchemas() {
+    return {
+        kotlin: parseFieldLists(readFileSync(paths.kotlinSchema, "utf8"), /\bval (\w+) = listOf\(/g),
+        swift: parseFieldLists(readFileSync(paths.swiftSchema, "utf8"), /static let (\w+): \[WireField\] = \[/g),
+    };
+}
+
+/**
+ * 与 WireSchema.pack（Kotlin/Swift）相同：缺失字段为 null，嵌套字段只在值为对象时递归
+ */
+export function pack(item, schema) {
+    return schema.map((field) => {
+        const key = typeof field === "string" ? field : field[0];
+        const value = item?.[key];
+        if (value === undefined || value === null) return null;
+        if (typeof field !== "string" && typeof value === "object" && !Array.isArray(value)) {
+            return pack(value, field[1]);
+        }
+        return value;
+    });
+}
+
+export function encode(items, schema, header = []) {
+    return JSON.stringify(["c1", ...header, ...items.map((item) => pack(item, schema))]);
+}
+
+export function encodeMap(map) {
+    return JSON.stringify(["c1", ...Object.entries(map).flat()]);
+}
+
+const user = (i) => ({ userID: `user_${i}`, userName: `观众${i}`, avatarURL: `https://example.com/avatar/${i % 50}.png` });
+
+export function makeBarrage(i) {
+    return {
+        liveID: "live_bench",
+        sender: user(i),
+        sequence: 1000 + i,
+        timestampInSecond: 1750000000 + i,
+        messageType: i % 7 === 0 ? 1 : 0,
+        textContent: `第 ${i} 条弹幕消息`,
+        extensionInfo: i % 5 === 0 ? { level: String(i % 30) } : {},
+        businessID: "",
+        data: "",
+    };
+}
+
+export function makeSeat(i) {
+    const seat = {
+        index: i,
+        isLocked: i % 9 === 8,
+        region: { x: (i % 3) * 240, y: Math.floor(i / 3) * 320, w: 240, h: 320, zorder: i },
+    };
+    if (i % 4 !== 3) {
+        seat.userInfo = {
+            ...user(i), role: i === 0 ? 0 : 2, liveID: "live_bench", microphoneStatus: i % 2, allowOpenMicrophone: true,
+            cameraStatus: i % 3 === 0 ? 1 : 0, allowOpenCamera: true,
+        };
+    }
+    return seat;
+}
+
+export function makeLiveInfo(i) {
+    return {
+        liveID: `live_${i}`, liveName: `直播间 ${i}`, notice: "", isMessageDisable: false, isPublicVisible: true,
+        isSeatEnabled: true, keepOwnerOnSeat: true, maxSeatCount: 9, seatMode: 1, seatLayoutTemplateID: 600,
+        coverURL: `https://example.com/cover/${i}.png`, backgroundURL: "", activityStatus: 0, liveOwner: user(i),
+        createTime: 1750000000000 + i, categoryList: [i % 4], totalViewerCount: i * 13, isGiftEnabled: true,
+        metaData: i % 2 ? { topic: "music" } : {},
+    };
+}
+
+export function makeNetworkInfo(i) {
+    return { userID: `user_${i}`, quality: i % 6, upLoss: i % 10, downLoss: (i * 3) % 10, delay: 40 + i };
+}
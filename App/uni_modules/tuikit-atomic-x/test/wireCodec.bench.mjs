@@ -0,0 +1,44 @@
+/**
+ * 紧凑格式基准：对比 JSON 与紧凑格式的单条事件字节数与 JS 侧解码耗时
+ * 运行：node test/wireCodec.bench.mjs [iterations]
+ */
+import { loadTs } from "./support/loadTs.mjs";
+import {
+    paths, utsUtilsStub, readNativeSchemas, encode,
+    makeBarrage, makeSeat, makeLiveInfo, makeNetworkInfo,
+} from "./support/wireFixtures.mjs";
+
+const iterations = Number(process.argv[2]) || 2000;
+const codec = await loadTs(paths.wireCodec, { "./utsUtils": utsUtilsStub });
+const { WireSchema } = codec;
+const native = readNativeSchemas();
+
+const cases = [
+    { name: "seatList (9 seats)", items: Array.from({ length: 9 }, (_, i) => makeSeat(i)), schema: "seatInfo" },
+    { name: "messageListReset (100)", items: Array.from({ length: 100 }, (_, i) => makeBarrage(i)), schema: "barrage" },
+    { name: "liveList (20)", items: Array.from({ length: 20 }, (_, i) => makeLiveInfo(i)), schema: "liveInfo" },
+    { name: "networkInfo (1)", items: [makeNetworkInfo(1)], schema: "networkInfo" },
+];
+
+function timeDecode(decode) {
+    for (let i = 0; i < Math.min(200, iterations); i++) decode();
+    const start = process.hrtime.bigint();
+    for (let i = 0; i < iterations; i++) decode();
+    return Number(process.hrtime.bigint() - start) / iterations / 1000;
+}
+
+const rows = cases.map(({ name, items, schema }) => {
+    const json = JSON.stringify(items);
+    const wire = encode(items, native.kotlin[schema]);
+    return {
+        event: name,
+        jsonBytes: Buffer.byteLength(json),
+        wireBytes: Buffer.byteLength(wire),
+        saved: `${(100 - Buffer.byteLength(wire) * 100 / Buffer.byteLength(json)).toFixed(1)}%`,
+        jsonDecodeUs: timeDecode(() => codec.parseWireList(json, WireSchema[schema])).toFixed(2),
+        wireDecodeUs: timeDecode(() => codec.parseWireList(wire, WireSchema[schema])).toFixed(2),
+    };
+});
+
+console.log(`node ${process.version}, ${iterations} iterations per case`);
+console.table(rows);
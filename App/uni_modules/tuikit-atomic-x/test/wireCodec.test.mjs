@@ -0,0 +1,68 @@
+/**
+ * 紧凑传输格式往返测试：JS 与 native 两侧 schema 字段顺序一致，按 native 规则编码的数据经 wireCodec 解码后与原数据相同
+ * 运行：node --test test/*.test.mjs
+ */
+import { test } from "node:test";
+import assert from "node:assert/strict";
+import { loadTs } from "./support/loadTs.mjs";
+import {
+    paths, utsUtilsStub, readNativeSchemas, encode, encodeMap,
+    makeBarrage, makeSeat, makeLiveInfo, makeNetworkInfo,
+} from "./support/wireFixtures.mjs";
+
+const codec = await loadTs(paths.wireCodec, { "./utsUtils": utsUtilsStub });
+const { WireSchema } = codec;
+const native = readNativeSchemas();
+
+test("native schemas match the JS WireSchema column order", () => {
+    for (const name of Object.keys(WireSchema)) {
+        assert.deepEqual(native.kotlin[name], WireSchema[name], `WireSchema.kt ${name}`);
+        assert.deepEqual(native.swift[name], WireSchema[name], `WireSchema.swift ${name}`);
+    }
+    assert.deepEqual(Object.keys(native.kotlin).sort(), Object.keys(WireSchema).sort());
+    assert.deepEqual(Object.keys(native.swift).sort(), Object.keys(WireSchema).sort());
+});
+
+test("parseWireList round-trips seatList, including empty seats", () => {
+    const seats = Array.from({ length: 9 }, (_, i) => makeSeat(i));
+    const res = encode(seats, native.kotlin.seatInfo);
+    assert.ok(codec.isWirePayload(res));
+    assert.deepEqual(codec.parseWireList(res, WireSchema.seatInfo), seats);
+});
+
+test("parseWireList round-trips liveList", () => {
+    const lives = Array.from({ length: 20 }, (_, i) => makeLiveInfo(i));
+    assert.deepEqual(codec.parseWireList(encode(lives, native.swift.liveInfo), WireSchema.liveInfo), lives);
+});
+
+test("decodeWireRows splits the messageListAppend header from rows", () => {
+    const messages = Array.from({ length: 5 }, (_, i) => makeBarrage(i));
+    const decoded = codec.decodeWireRows(encode(messages, native.kotlin.barrage, [120]), WireSchema.barrage, 1);
+    assert.deepEqual(decoded.header, [120]);
+    assert.deepEqual(decoded.rows, messages);
+});
+
+test("parseWireObject round-trips networkInfo", () => {
+    const info = makeNetworkInfo(3);
+    assert.deepEqual(codec.parseWireObject(encode([info], native.kotlin.networkInfo), WireSchema.networkInfo, {}), info);
+});
+
+test("missing and null fields are omitted like the JSON format", () => {
+    const sparse = { liveID: "live_1", sender: { userID: "u1" }, sequence: 1, textContent: null };
+    const decoded = codec.parseWireList(encode([sparse], native.kotlin.barrage), WireSchema.barrage);
+    assert.deepEqual(decoded, [{ liveID: "live_1", sender: { userID: "u1" }, sequence: 1 }]);
+});
+
+test("parseWireMap round-trips speakingUsers", () => {
+    const speaking = { user_1: 80, user_2: 0, user_3: 35 };
+    assert.deepEqual(codec.parseWireMap(encodeMap(speaking), null), speaking);
+    assert.deepEqual(codec.parseWireMap(encodeMap({}), null), {});
+});
+
+test("JSON payloads still decode unchanged", () => {
+    const seats = [makeSeat(0), makeSeat(3)];
+    assert.equal(codec.isWirePayload(JSON.stringify(seats)), false);
+    assert.deepEqual(codec.parseWireList(JSON.stringify(seats), WireSchema.seatInfo), seats);
+    assert.deepEqual(codec.parseWireMap(JSON.stringify({ user_1: 10 }), null), { user_1: 10 });
+    assert.deepEqual(codec.parseWireList("not json", WireSchema.seatInfo, []), []);
+});
@@ -0,0 +1,156 @@
+import { callUTSFunction } from "./utsUtils";
+
+/**
+ * 超时错误码
+ */
+export const UTS_ERROR_TIMEOUT = -1001;
+
+/**
+ * 取消错误码
+ */
+export const UTS_ERROR_ABORTED = -1002;
+
+/**
+ * 默认超时时间（毫秒），未列出的操作使用 DEFAULT_TIMEOUT
+ */
+const DEFAULT_TIMEOUT = 10000;
+const OPERATION_TIMEOUTS: Record<string, number> = {
+    login: 15000,
+    createLive: 15000,
+    joinLive: 15000,
+    fetchLiveList: 8000,
+    fetchAudienceList: 8000,
+    fetchAudienceListPage: 8000,
+    refreshUsableGifts: 8000,
+    openLocalCamera: 8000,
+    openLocalMicrophone: 8000,
+    // 邀请、申请类操作需要等待对方响应
+    applyForSeat: 60000,
+    inviteToSeat: 60000,
+    requestHostConnection: 60000,
+};
+
+/**
+ * 取消信号，与 AbortSignal 兼容，运行环境不支持 AbortController 时由 createAbortController 提供
+ */
+export type AbortSignalLike = {
+    readonly aborted: boolean;
+    addEventListener(type: "abort", listener: () => void): void;
+    removeEventListener(type: "abort", listener: () => void): void;
+};
+
+/**
+ * 异步调用选项
+ * @typedef {Object} AsyncCallOptions
+ * @property {number} [timeout] - 超时时间（毫秒），默认按操作取值，小于等于 0 表示不超时
+ * @property {AbortSignalLike} [signal] - 取消信号
+ */
+export type AsyncCallOptions = {
+    timeout?: number;
+    signal?: AbortSignalLike;
+};
+
+/**
+ * 异步调用失败：native 返回的错误码，或 UTS_ERROR_TIMEOUT / UTS_ERROR_ABORTED
+ */
+export class UTSCallError extends Error {
+    funcName: string;
+    code: number;
+
+    constructor(funcName: string, code: number, message: string) {
+        super(`[${funcName}] ${code}: ${message}`);
+        this.funcName = funcName;
+        this.code = code;
+    }
+}
+
+/**
+ * 创建取消控制器，优先使用运行环境的 AbortController
+ * @example
+ * const controller = createAbortController();
+ * joinLiveAsync({ liveID }, { signal: controller.signal });
+ * controller.abort();
+ */
+export function createAbortController(): { signal: AbortSignalLike, abort: () => void } {
+    if (typeof AbortController !== "undefined") {
+        return new AbortController();
+    }
+    const listeners = new Set<() => void>();
+    const signal = {
+        aborted: false,
+        addEventListener: (_type: "abort", listener: () => void) => listeners.add(listener),
+        removeEventListener: (_type: "abort", listener: () => void) => listeners.delete(listener),
+    };
+    return {
+        signal,
+        abort: () => {
+            if (signal.aborted) {
+                return;
+            }
+            signal.aborted = true;
+            Array.from(listeners).forEach(listener => listener());
+            listeners.clear();
+        },
+    };
+}
+
+type CallbackParams = {
+    success?: (...args: any[]) => void;
+    fail?: (errCode: number, errMsg: string) => void;
+};
+
+/**
+ * 将回调风格的操作方法转换为返回 Promise 的版本。超时或取消只结束 JS 侧等待，
+ * native 操作仍会继续执行，其之后到达的回调被忽略
+ * @param funcName UTS函数名，用于默认超时与错误信息
+ * @param fn 回调风格的操作方法，success/fail 由本方法注入
+ */
+export function promisifyUTSCall<P extends CallbackParams, T = string | undefined>(funcName: string, fn: (params: P) => void) {
+    return (params?: Omit<P, "success" | "fail">, options?: AsyncCallOptions): Promise<T> => {
+        return new Promise<T>((resolve, reject) => {
+            const signal = options?.signal;
+            if (signal?.aborted) {
+                reject(new UTSCallError(funcName, UTS_ERROR_ABORTED, "aborted"));
+                return;
+            }
+            let settled = false;
+            let timer: ReturnType<typeof setTimeout> | null = null;
+            const onAbort = () => settle(() => reject(new UTSCallError(funcName, UTS_ERROR_ABORTED, "aborted")));
+            const settle = (done: () => void) => {
+                if (settled) {
+                    return;
+                }
+                settled = true;
+                if (timer) {
+                    clearTimeout(timer);
+                }
+                signal?.removeEventListener("abort", onAbort);
+                done();
+            };
+            const timeout = options?.timeout ?? OPERATION_TIMEOUTS[funcName] ?? DEFAULT_TIMEOUT;
+            if (timeout > 0) {
+                timer = setTimeout(() => {
+                    console.warn(`[${funcName}] timeout after ${timeout}ms`);
+                    settle(() => reject(new UTSCallError(funcName, UTS_ERROR_TIMEOUT, `timeout after ${timeout}ms`)));
+                }, timeout);
+            }
+            signal?.addEventListener("abort", onAbort);
+            fn({
+                ...(params || {}),
+                success: (data?: T) => settle(() => resolve(data as T)),
+                fail: (errCode: number, errMsg: string) => settle(() => reject(new UTSCallError(funcName, errCode, errMsg))),
+            } as P);
+        });
+    };
+}
+
+/**
+ * 调用 UTS 函数并返回 Promise，适用于未在 state 模块中封装的操作
+ * @example
+ * import { callUTSFunctionAsync } from '@/uni_modules/tuikit-atomic-x/utils/asyncCall';
+ * await callUTSFunctionAsync("fetchAudienceList", { liveID }, { timeout: 5000 });
+ */
+export function callUTSFunctionAsync<T = string | undefined>(funcName: string, params?: Record<string, any>,
+    options?: AsyncCallOptions): Promise<T> {
+    return promisifyUTSCall<CallbackParams, T>(funcName, (args) => callUTSFunction(funcName, args))(params, options);
+}
@@ -0,0 +1,154 @@
+/**
+ * bridge 指标：JS 侧按 store 事件与 key 统计 JSON 解析耗时与监听函数执行耗时，
+ * 与 native 侧的下发频率、字节数、编码耗时合并导出。默认关闭，关闭时每次分发只多一次布尔判断
+ * @module BridgeMetrics
+ */
+import { getRTCRoomEngineManager } from "../state/rtcRoomEngine";
+import { safeJsonParse } from "./utsUtils";
+
+/**
+ * 每个 (store, key) 保留的最近样本数，用于计算滚动分位数
+ */
+const SAMPLE_COUNT = 128;
+
+type KeyStats = {
+    count: number;
+    parseMs: number;
+    listenerMs: number;
+    parseSamples: number[];
+    listenerSamples: number[];
+    index: number;
+};
+
+type DispatchToken = {
+    stats: KeyStats;
+    startedAt: number;
+    parseMs: number;
+    previous: DispatchToken | null; // 监听函数内触发的嵌套分发结束后恢复外层计时
+};
+
+let enabled = false;
+let logTimer: ReturnType<typeof setInterval> | null = null;
+const stats = new Map<string, KeyStats>();
+let currentDispatch: DispatchToken | null = null;
+
+const now: () => number = typeof performance !== "undefined" && performance.now
+    ? () => performance.now()
+    : () => Date.now();
+
+/**
+ * bridge 指标开关选项
+ * @typedef {Object} BridgeMetricsOptions
+ * @property {number} [logIntervalMs] - 大于 0 时按该间隔输出一行指标日志
+ */
+export type BridgeMetricsOptions = {
+    logIntervalMs?: number;
+};
+
+export function isBridgeMetricsEnabled(): boolean {
+    return enabled;
+}
+
+/**
+ * 开启或关闭 bridge 指标采集（JS 与 native 两侧），开启时清空之前的数据
+ * @param {boolean} enable - 是否开启
+ * @param {BridgeMetricsOptions} [options] - 选项
+ * @example
+ * import { setBridgeMetricsEnabled, getBridgeMetricsSnapshot } from '@/uni_modules/tuikit-atomic-x/utils/bridgeMetrics';
+ * setBridgeMetricsEnabled(true, { logIntervalMs: 10000 });
+ * console.log(JSON.stringify(getBridgeMetricsSnapshot()));
+ */
+export function setBridgeMetricsEnabled(enable: boolean, options?: BridgeMetricsOptions): void {
+    if (enable && !enabled) {
+        stats.clear();
+    }
+    enabled = enable;
+    getRTCRoomEngineManager().setBridgeMetrics({ enabled: enable });
+    if (logTimer) {
+        clearInterval(logTimer);
+        logTimer = null;
+    }
+    if (enable && options?.logIntervalMs && options.logIntervalMs > 0) {
+        logTimer = setInterval(() => {
+            console.log(`[BridgeMetrics] ${JSON.stringify(getBridgeMetricsSnapshot())}`);
+        }, options.logIntervalMs);
+    }
+}
+
+function getKeyStats(eventName: string, key: string): KeyStats {
+    const id = `${eventName}.${key}`;
+    let keyStats = stats.get(id);
+    if (!keyStats) {
+        keyStats = { count: 0, parseMs: 0, listenerMs: 0, parseSamples: [], listenerSamples: [], index: 0 };
+        stats.set(id, keyStats);
+    }
+    return keyStats;
+}
+
+/**
+ * 开始一次 store 事件分发的计时，仅在开启时调用
+ */
+export function beginDispatch(eventName: string, key: string): DispatchToken {
+    const token = { stats: getKeyStats(eventName, key), startedAt: now(), parseMs: 0, previous: currentDispatch };
+    currentDispatch = token;
+    return token;
+}
+
+/**
+ * 结束分发计时：监听函数耗时包含其中的 JSON 解析耗时
+ */
+export function endDispatch(token: DispatchToken): void {
+    const keyStats = token.stats;
+    const listenerMs = now() - token.startedAt;
+    keyStats.count++;
+    keyStats.parseMs += token.parseMs;
+    keyStats.listenerMs += listenerMs;
+    keyStats.parseSamples[keyStats.index] = token.parseMs;
+    keyStats.listenerSamples[keyStats.index] = listenerMs;
+    keyStats.index = (keyStats.index + 1) % SAMPLE_COUNT;
+    currentDispatch = token.previous;
+}
+
+/**
+ * 记录一次 JSON 解析耗时，归到当前正在分发的事件；不在分发过程中的解析不计入
+ */
+export function recordParse(ms: number): void {
+    if (currentDispatch) {
+        currentDispatch.parseMs += ms;
+    }
+}
+
+export function measureNow(): number {
+    return now();
+}
+
+function percentile(samples: number[], p: number): number {
+    if (samples.length === 0) {
+        return 0;
+    }
+    const sorted = samples.slice().sort((a, b) => a - b);
+    return sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p / 100))];
+}
+
+/**
+ * 导出指标快照：native 为 native 侧数据（keys 以 store.key 为键），js 以 eventName.key 为键
+ * @returns {{ native: object, js: object }}
+ */
+export function getBridgeMetricsSnapshot(): { native: object, js: Record<string, object> } {
+    const js: Record<string, object> = {};
+    stats.forEach((keyStats, id) => {
+        js[id] = {
+            count: keyStats.count,
+            parseMs: keyStats.parseMs,
+            parseP50Ms: percentile(keyStats.parseSamples, 50),
+            parseP95Ms: percentile(keyStats.parseSamples, 95),
+            listenerMs: keyStats.listenerMs,
+            listenerP50Ms: percentile(keyStats.listenerSamples, 50),
+            listenerP95Ms: percentile(keyStats.listenerSamples, 95),
+        };
+    });
+    return {
+        native: safeJsonParse<object>(getRTCRoomEngineManager().getBridgeMetrics(), {}),
+        js,
+    };
+}
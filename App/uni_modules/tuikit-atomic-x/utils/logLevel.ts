@@ -0,0 +1,56 @@
+/**
+ * 日志级别：JS 侧调用日志与 native 插件日志共用同一级别设置，Release 包默认只输出 warn 及以上
+ * @module LogLevel
+ */
+import { getRTCRoomEngineManager } from "../state/rtcRoomEngine";
+
+export type LogLevel = "debug" | "info" | "warn" | "error" | "none";
+
+const LEVEL_ORDER: Record<LogLevel, number> = {
+    debug: 0,
+    info: 1,
+    warn: 2,
+    error: 3,
+    none: 4,
+};
+
+let currentLevel: number = process.env.NODE_ENV === "production" ? LEVEL_ORDER.warn : LEVEL_ORDER.info;
+
+/**
+ * 日志级别选项
+ * @typedef {Object} LogLevelOptions
+ * @property {string} [module] - 只设置该 native 模块的级别，如 Live、LiveSeat、Gift，不影响 JS 侧
+ * @property {number} [payloadMaxLength] - native 日志中参数与事件数据的最大长度
+ * @property {number} [payloadSampleInterval] - native store 事件日志每 N 条输出一条
+ */
+export type LogLevelOptions = {
+    module?: string;
+    payloadMaxLength?: number;
+    payloadSampleInterval?: number;
+};
+
+/**
+ * 设置日志级别
+ * @param {LogLevel} level - 日志级别
+ * @param {LogLevelOptions} [options] - 选项
+ * @example
+ * import { setLogLevel } from '@/uni_modules/tuikit-atomic-x/utils/logLevel';
+ * setLogLevel('debug', { module: 'LiveSeat', payloadSampleInterval: 10 });
+ */
+export function setLogLevel(level: LogLevel, options?: LogLevelOptions): void {
+    if (!(level in LEVEL_ORDER)) {
+        console.warn(`setLogLevel: unknown log level "${level}", keep current level`);
+        return;
+    }
+    if (!options?.module) {
+        currentLevel = LEVEL_ORDER[level];
+    }
+    getRTCRoomEngineManager().setLogLevel({ level, ...(options || {}) });
+}
+
+/**
+ * 是否输出该级别的 JS 侧日志，拼接日志参数前调用
+ */
+export function isLogEnabled(level: LogLevel): boolean {
+    return LEVEL_ORDER[level] >= currentLevel;
+}
@@ -0,0 +1,73 @@
+/**
+ * 会话快照：持久化上次登录用户、直播列表首页与可用礼物，启动时同步读取用于首屏渲染，
+ * 登录完成后以 store 下发的数据为准覆盖快照
+ * @module SessionSnapshot
+ */
+
+/**
+ * 快照分段
+ */
+export type SessionSection = "loginUserInfo" | "liveList" | "usableGifts";
+
+type SnapshotEntry<T> = {
+    value: T;
+    savedAt: number;
+};
+
+const STORAGE_KEY_PREFIX = "atomicx_session_";
+
+/**
+ * 各分段的有效期（毫秒），超过有效期的快照在读取时丢弃
+ */
+const SESSION_TTL: Record<SessionSection, number> = {
+    loginUserInfo: 7 * 24 * 60 * 60 * 1000,
+    liveList: 30 * 60 * 1000,
+    usableGifts: 24 * 60 * 60 * 1000,
+};
+
+const SECTIONS: SessionSection[] = ["loginUserInfo", "liveList", "usableGifts"];
+
+/**
+ * 同步读取快照，不存在、已过期或解析失败时返回 undefined
+ * @param {SessionSection} section - 快照分段
+ */
+export function readSessionSnapshot<T>(section: SessionSection): T | undefined {
+    try {
+        const entry = uni.getStorageSync(STORAGE_KEY_PREFIX + section) as SnapshotEntry<T> | "";
+        if (!entry) {
+            return undefined;
+        }
+        if (Date.now() - entry.savedAt > SESSION_TTL[section]) {
+            uni.removeStorage({ key: STORAGE_KEY_PREFIX + section });
+            return undefined;
+        }
+        return entry.value;
+    } catch (error) {
+        console.error(`readSessionSnapshot ${section} error:`, error);
+        return undefined;
+    }
+}
+
+/**
+ * 写入快照，异步落盘不阻塞调用方
+ * @param {SessionSection} section - 快照分段
+ * @param {T} value - 快照数据
+ */
+export function writeSessionSnapshot<T>(section: SessionSection, value: T): void {
+    const entry: SnapshotEntry<T> = { value, savedAt: Date.now() };
+    uni.setStorage({
+        key: STORAGE_KEY_PREFIX + section,
+        data: entry,
+        fail: (error) => console.error(`writeSessionSnapshot ${section} error:`, error),
+    });
+}
+
+/**
+ * 清除快照，不传 section 时清除全部分段（登出或切换用户时调用）
+ * @param {SessionSection} [section] - 快照分段
+ */
+export function clearSessionSnapshot(section?: SessionSection): void {
+    (section ? [section] : SECTIONS).forEach((item) => {
+        uni.removeStorage({ key: STORAGE_KEY_PREFIX + item });
+    });
+}
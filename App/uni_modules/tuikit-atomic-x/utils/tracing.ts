@@ -0,0 +1,170 @@
+/**
+ * 链路追踪：JS 侧按 (name, key) 记录带 ID 的起止 span 与一次性标记，写入固定大小的环形缓冲区；
+ * 导出时与 native 侧的命令执行、store 首次下发、渲染视图挂载事件合并为 Chrome trace_event JSON，
+ * 可直接在 chrome://tracing 或 Perfetto 中打开
+ * @module Tracing
+ */
+import { getRTCRoomEngineManager } from "../state/rtcRoomEngine";
+import { safeJsonParse } from "./utsUtils";
+
+/**
+ * 环形缓冲区容量，写满后覆盖最旧的事件
+ */
+const RING_SIZE = 2048;
+
+const JS_PID = 1;
+const NATIVE_PID = 2;
+
+type TraceEvent = {
+    name: string;
+    cat: string;
+    ph: string;
+    ts: number;
+    pid: number;
+    tid: number;
+    id?: number;
+    s?: string;
+    args?: Record<string, any>;
+};
+
+const ring: TraceEvent[] = [];
+let ringIndex = 0;
+let nextSpanID = 1;
+const openSpans = new Map<string, number>(); // name|key -> span ID
+const firstMarks = new Set<string>();         // 已记录的 name|key 一次性标记
+
+// Unix 微秒，与 native 侧时间戳对齐
+const nowMicros: () => number = typeof performance !== "undefined" && performance.now && performance.timeOrigin
+    ? () => Math.round((performance.timeOrigin + performance.now()) * 1000)
+    : () => Date.now() * 1000;
+
+function push(event: TraceEvent): void {
+    if (ring.length < RING_SIZE) {
+        ring.push(event);
+    } else {
+        ring[ringIndex] = event;
+    }
+    ringIndex = (ringIndex + 1) % RING_SIZE;
+}
+
+/**
+ * 开始一个 span，同一 (name, key) 未结束时再次开始会先结束上一个
+ * @param {string} name - span 名称，如 joinLive
+ * @param {string} [key] - 区分并发的同名 span，如 liveID
+ * @returns {number} span ID
+ */
+export function beginSpan(name: string, key: string = "", args?: Record<string, any>): number {
+    const spanKey = `${name}|${key}`;
+    if (openSpans.has(spanKey)) {
+        endSpan(name, key, { interrupted: true });
+    }
+    const id = nextSpanID++;
+    openSpans.set(spanKey, id);
+    push({ name, cat: "atomicx", ph: "b", ts: nowMicros(), pid: JS_PID, tid: 1, id, args: { key, ...args } });
+    return id;
+}
+
+/**
+ * 结束 span，未开始的 (name, key) 忽略
+ */
+export function endSpan(name: string, key: string = "", args?: Record<string, any>): void {
+    const spanKey = `${name}|${key}`;
+    const id = openSpans.get(spanKey);
+    if (id === undefined) {
+        return;
+    }
+    openSpans.delete(spanKey);
+    push({ name, cat: "atomicx", ph: "e", ts: nowMicros(), pid: JS_PID, tid: 1, id, args });
+}
+
+/**
+ * 记录瞬时事件
+ */
+export function traceInstant(name: string, args?: Record<string, any>): void {
+    push({ name, cat: "atomicx", ph: "i", s: "t", ts: nowMicros(), pid: JS_PID, tid: 1, args });
+}
+
+/**
+ * 每个 (name, key) 只记录一次的标记，如某直播间的首次 seatList；clearFirstMarks 后可再次记录
+ */
+export function markFirst(name: string, key: string = ""): void {
+    const markKey = `${name}|${key}`;
+    if (firstMarks.has(markKey)) {
+        return;
+    }
+    firstMarks.add(markKey);
+    traceInstant(name, { key });
+}
+
+/**
+ * 清除某个 key（如 liveID）的一次性标记，重新进入直播间前调用
+ */
+export function clearFirstMarks(key: string): void {
+    Array.from(firstMarks).forEach((markKey) => {
+        if (markKey.endsWith(`|${key}`)) {
+            firstMarks.delete(markKey);
+        }
+    });
+}
+
+/**
+ * 为回调风格的调用参数包装 span：调用前开始，success/fail 时结束，失败时记录错误码
+ */
+export function traceCallback<P extends { success?: (...args: any[]) => void, fail?: (errCode: number, errMsg: string) => void }>(
+    name: string, key: string, params: P): P {
+    beginSpan(name, key);
+    return {
+        ...params,
+        success: (...args: any[]) => {
+            endSpan(name, key);
+            params.success?.(...args);
+        },
+        fail: (errCode: number, errMsg: string) => {
+            endSpan(name, key, { errCode, errMsg });
+            if (params.fail) {
+                params.fail(errCode, errMsg);
+            } else {
+                console.error(`[${name}] Failed:`, { errCode, errMsg });
+            }
+        },
+    };
+}
+
+/**
+ * 开启或关闭 native 侧追踪（默认开启），JS 侧始终记录
+ */
+export function setNativeTracingEnabled(enable: boolean): void {
+    getRTCRoomEngineManager().setTracing({ enabled: enable });
+}
+
+/**
+ * 清空 JS 与 native 两侧已记录的事件，未结束的 span 保留
+ */
+export function clearTrace(): void {
+    ring.length = 0;
+    ringIndex = 0;
+    getRTCRoomEngineManager().clearTraceEvents();
+}
+
+/**
+ * 导出 Chrome trace_event JSON（JSON Object Format），JS 事件在 pid 1，native 事件在 pid 2
+ * @example
+ * import { dumpChromeTrace } from '@/uni_modules/tuikit-atomic-x/utils/tracing';
+ * const json = dumpChromeTrace(); // 保存为 .json 后在 chrome://tracing 中打开
+ */
+export function dumpChromeTrace(): string {
+    const jsEvents = ring.length < RING_SIZE ? ring.slice() : ring.slice(ringIndex).concat(ring.slice(0, ringIndex));
+    const nativeEvents = safeJsonParse<TraceEvent[]>(getRTCRoomEngineManager().getTraceEvents(), [])
+        .map(event => ({ ...event, pid: NATIVE_PID }));
+    const metadata = [
+        { name: "process_name", ph: "M", pid: JS_PID, tid: 0, args: { name: "js" } },
+        { name: "process_name", ph: "M", pid: NATIVE_PID, tid: 0, args: { name: "native" } },
+        { name: "thread_name", ph: "M", pid: NATIVE_PID, tid: 1, args: { name: "main" } },
+        { name: "thread_name", ph: "M", pid: NATIVE_PID, tid: 2, args: { name: "command" } },
+        { name: "thread_name", ph: "M", pid: NATIVE_PID, tid: 3, args: { name: "store" } },
+    ];
+    return JSON.stringify({
+        traceEvents: [...metadata, ...jsEvents, ...nativeEvents],
+        displayTimeUnit: "ms",
+    });
+}
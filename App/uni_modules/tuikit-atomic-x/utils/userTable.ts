@@ -0,0 +1,73 @@
+import { shallowReactive } from "vue";
+import { LiveUserInfoParam } from "@/uni_modules/tuikit-atomic-x";
+import { callUTSFunction, safeJsonParse } from "./utsUtils";
+import { WireSchema, isWirePayload, unpackRow } from "./wireCodec";
+
+/**
+ * native 侧淘汰的句柄延迟删除，避免其他 store 已编码、尚未投递的数据引用不到资料
+ */
+const EVICT_DELAY_MS = 1000;
+
+/**
+ * 共享用户表：句柄 -> 用户资料，由 native 侧 UserInternTable 通过 userProfiles 事件维护。
+ * 同一用户的消息、观众条目共享同一个资料对象
+ */
+export const userTable = shallowReactive(new Map<number, LiveUserInfoParam>());
+
+type UserProfilesPayload = {
+    users ?: Record<string, LiveUserInfoParam>;
+    evicted ?: number[];
+};
+
+/**
+ * 应用 userProfiles 事件：登记新资料，延迟删除被淘汰的句柄
+ */
+export function applyUserProfiles(res : string) : void {
+    const payload = safeJsonParse<UserProfilesPayload>(res, {});
+    Object.keys(payload.users || {}).forEach((handle) => {
+        userTable.set(Number(handle), payload.users![handle]);
+    });
+    if (payload.evicted?.length) {
+        const evicted = payload.evicted;
+        setTimeout(() => evicted.forEach(handle => userTable.delete(handle)), EVICT_DELAY_MS);
+    }
+}
+
+/**
+ * 将句柄、紧凑格式行或用户对象统一还原为用户资料
+ */
+export function resolveUser(value : number | any[] | LiveUserInfoParam | null | undefined) : LiveUserInfoParam {
+    if (typeof value === "number") {
+        const user = userTable.get(value);
+        if (!user) {
+            console.warn(`resolveUser: unknown user handle ${value}`);
+            return { userID: "", userName: "", avatarURL: "" };
+        }
+        return user;
+    }
+    if (Array.isArray(value)) {
+        return unpackRow<LiveUserInfoParam>(value, WireSchema.liveUserInfo);
+    }
+    return value || {};
+}
+
+/**
+ * 解析用户列表事件，兼容句柄、紧凑格式与 JSON 格式
+ */
+export function parseUserList(res : string) : LiveUserInfoParam[] {
+    const payload = safeJsonParse<any[]>(res, []);
+    const items = isWirePayload(res) ? payload.slice(1) : payload;
+    return items.map(item => resolveUser(item));
+}
+
+/**
+ * 开启或关闭用户资料驻留：开启后 messageList、audienceList 中的用户只携带句柄，资料只下发一次
+ * @param {boolean} enabled - 是否开启
+ * @param {number} [capacity=1000] - native 侧驻留表容量，超出后按最近使用淘汰；最小 100（需容纳一次全量列表的用户），更小的值按 100 生效
+ * @example
+ * import { setUserInterning } from '@/uni_modules/tuikit-atomic-x/utils/userTable';
+ * setUserInterning(true);
+ */
+export function setUserInterning(enabled : boolean, capacity = 1000) : void {
+    callUTSFunction("setUserInterning", { enabled, capacity });
+}
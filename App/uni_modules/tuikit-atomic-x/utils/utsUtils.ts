@@ -1,4 +1,6 @@
 import { getRTCRoomEngineManager } from "../state/rtcRoomEngine";
+import { isBridgeMetricsEnabled, measureNow, recordParse } from "./bridgeMetrics";
+import { isLogEnabled } from "./logLevel";
 
 /**
  * 安全的JSON解析函数
@@ -6,11 +8,96 @@ import { getRTCRoomEngineManager } from "../state/rtcRoomEngine";
  * @param defaultValue 解析失败时的默认值
  */
 export function safeJsonParse<T>(jsonString: string, defaultValue: T): T {
+    const startedAt = isBridgeMetricsEnabled() ? measureNow() : 0;
     try {
         return JSON.parse(jsonString);
     } catch (error) {
         console.error("JSON parse error:", error);
         return defaultValue;
+    } finally {
+        if (startedAt) {
+            recordParse(measureNow() - startedAt);
+        }
+    }
+}
+
+/**
+ * 可批量下发的 UTS 函数。同一 JS tick 内的调用合并为一次 native 调用并按顺序执行；
+ * coalesce 为 true 的 setter 没有回调，同一批次内只保留最后一次的值
+ */
+const BATCHABLE_FUNCTIONS: Record<string, { coalesce: boolean }> = {
+    setSmoothLevel: { coalesce: true },
+    setWhitenessLevel: { coalesce: true },
+    setRuddyLevel: { coalesce: true },
+    setCaptureVolume: { coalesce: true },
+    setOutputVolume: { coalesce: true },
+    setVoiceEarMonitorVolume: { coalesce: true },
+    setVoiceEarMonitorEnable: { coalesce: true },
+    setAudioChangerType: { coalesce: true },
+    setAudioReverbType: { coalesce: true },
+    setAdministrator: { coalesce: false },
+    revokeAdministrator: { coalesce: false },
+    kickUserOutOfRoom: { coalesce: false },
+    disableSendMessage: { coalesce: false },
+};
+
+type PendingCall = {
+    funcName: string;
+    args: any;
+};
+
+let pendingCalls: PendingCall[] = [];
+let isFlushScheduled = false;
+
+function enqueueBatchCall(funcName: string, args: any): void {
+    const call = { funcName, args: args || {} };
+    const index = BATCHABLE_FUNCTIONS[funcName].coalesce
+        ? pendingCalls.findIndex(item => item.funcName === funcName) : -1;
+    if (index >= 0) {
+        // 保留原位置，只更新为最后一次的值
+        pendingCalls[index] = call;
+    } else {
+        pendingCalls.push(call);
+    }
+    if (!isFlushScheduled) {
+        isFlushScheduled = true;
+        Promise.resolve().then(flushBatchCalls);
+    }
+}
+
+/**
+ * 立即下发当前批次；非批量调用发起前会先调用，保证与之前的批量调用顺序一致
+ */
+export function flushBatchCalls(): void {
+    isFlushScheduled = false;
+    if (pendingCalls.length === 0) {
+        return;
+    }
+    const calls = pendingCalls;
+    pendingCalls = [];
+    if (isLogEnabled("info")) {
+        console.log(`[callBatch] Calling ${calls.length} functions:`, calls.map(call => call.funcName).join(","));
+    }
+    try {
+        getRTCRoomEngineManager().callBatch({
+            calls: calls.map(({ funcName, args }) => {
+                const { success, fail, ...params } = args;
+                return { funcName, args: JSON.stringify(params) };
+            }),
+            onResult: (index: number, code: number, message: string) => {
+                const { funcName, args } = calls[index];
+                if (code === 0) {
+                    args.success?.();
+                } else if (args.fail) {
+                    args.fail(code, message);
+                } else {
+                    console.error(`[${funcName}] Failed:`, { funcName, errCode: code, errMsg: message });
+                }
+            },
+        });
+    } catch (error) {
+        console.error(`[callBatch] Error calling UTS function:`, error);
+        calls.forEach(({ args }) => args.fail?.(-1, `Failed to call batch: ${error}`));
     }
 }
 
@@ -20,8 +107,17 @@ export function safeJsonParse<T>(jsonString: string, defaultValue: T): T {
  * @param args 函数参数，包含success和fail callback，直接传递对象
  */
 export function callUTSFunction(funcName: string, args?: any): void {
+    if (BATCHABLE_FUNCTIONS[funcName]) {
+        enqueueBatchCall(funcName, args);
+        return;
+    }
+    flushBatchCalls();
+
     const defaultCallback = {
         success: (res?: string) => {
+            if (!isLogEnabled("info")) {
+                return;
+            }
             console.log(`[${funcName}] Success:`, {
                 funcName,
                 args: JSON.stringify(args),
@@ -50,7 +146,9 @@ export function callUTSFunction(funcName: string, args?: any): void {
     
     // 直接调用UTS层
     try {
-        console.log(`[${funcName}] Calling with args:`, finalArgs);
+        if (isLogEnabled("debug")) {
+            console.log(`[${funcName}] Calling with args:`, finalArgs);
+        }
         
         // 直接传递对象给UTS层
         getRTCRoomEngineManager()[funcName](finalArgs);
@@ -0,0 +1,127 @@
+import { callUTSFunction, safeJsonParse } from "./utsUtils";
+
+/**
+ * 紧凑格式标记，native 侧紧凑编码的数据为以该标记开头的 JSON 数组
+ */
+export const WIRE_TAG = "c1";
+
+/**
+ * 紧凑格式字段定义，嵌套对象使用 [key, schema]
+ */
+export type WireSchemaDef = Array<string | [string, WireSchemaDef]>;
+
+const liveUserInfo : WireSchemaDef = ["userID", "userName", "avatarURL"];
+
+const seatUserInfo : WireSchemaDef = [
+    "userID", "userName", "avatarURL", "role", "liveID", "microphoneStatus", "allowOpenMicrophone",
+    "cameraStatus", "allowOpenCamera",
+];
+
+const region : WireSchemaDef = ["x", "y", "w", "h", "zorder"];
+
+/**
+ * 各事件的字段顺序，须与 native 侧 WireSchema（swift/WireSchema.swift、kotlin/observer/WireSchema.kt）保持一致
+ */
+export const WireSchema = {
+    liveUserInfo,
+    seatUserInfo,
+    region,
+    seatInfo: ["index", "isLocked", ["userInfo", seatUserInfo], ["region", region]] as WireSchemaDef,
+    barrage: [
+        "liveID", ["sender", liveUserInfo], "sequence", "timestampInSecond", "messageType", "textContent",
+        "extensionInfo", "businessID", "data",
+    ] as WireSchemaDef,
+    liveInfo: [
+        "liveID", "liveName", "notice", "isMessageDisable", "isPublicVisible", "isSeatEnabled", "keepOwnerOnSeat",
+        "maxSeatCount", "seatMode", "seatLayoutTemplateID", "coverURL", "backgroundURL", "activityStatus",
+        ["liveOwner", liveUserInfo], "createTime", "categoryList", "totalViewerCount", "isGiftEnabled", "metaData",
+    ] as WireSchemaDef,
+    networkInfo: ["userID", "quality", "upLoss", "downLoss", "delay"] as WireSchemaDef,
+};
+
+/**
+ * 判断数据是否为紧凑格式
+ */
+export function isWirePayload(res : string) : boolean {
+    return typeof res === "string" && res.startsWith(`["${WIRE_TAG}"`);
+}
+
+/**
+ * 按 schema 将一行字段值还原为对象，null 字段不输出，与 JSON 格式保持一致
+ */
+export function unpackRow<T>(row : any[], schema : WireSchemaDef) : T {
+    const result : Record<string, any> = {};
+    if (!Array.isArray(row)) {
+        return result as T;
+    }
+    for (let i = 0; i < schema.length; i++) {
+        const field = schema[i];
+        const value = row[i];
+        if (value === null || value === undefined) {
+            continue;
+        }
+        if (typeof field === "string") {
+            result[field] = value;
+        } else {
+            result[field[0]] = Array.isArray(value) ? unpackRow(value, field[1]) : value;
+        }
+    }
+    return result as T;
+}
+
+/**
+ * 解码列表类事件：紧凑格式 ["c1", ...header, ...rows]，JSON 格式直接解析
+ * @param headerSize - 紧凑格式中位于行数据之前的头部字段个数
+ * @returns {{ header: any[], rows: T[] } | null} 紧凑格式返回头部与行数据，非紧凑格式返回 null
+ */
+export function decodeWireRows<T>(res : string, schema : WireSchemaDef, headerSize = 0) : { header : any[], rows : T[] } | null {
+    if (!isWirePayload(res)) {
+        return null;
+    }
+    const payload = safeJsonParse<any[]>(res, [WIRE_TAG]);
+    const header = payload.slice(1, 1 + headerSize);
+    const rows = payload.slice(1 + headerSize).map(row => unpackRow<T>(row, schema));
+    return { header, rows };
+}
+
+/**
+ * 解析列表类事件，兼容紧凑格式与 JSON 格式
+ */
+export function parseWireList<T>(res : string, schema : WireSchemaDef, defaultValue : T[] = []) : T[] {
+    const decoded = decodeWireRows<T>(res, schema);
+    return decoded ? decoded.rows : safeJsonParse<T[]>(res, defaultValue);
+}
+
+/**
+ * 解析单对象事件，兼容紧凑格式 ["c1", row] 与 JSON 格式
+ */
+export function parseWireObject<T>(res : string, schema : WireSchemaDef, defaultValue : T) : T {
+    const decoded = decodeWireRows<T>(res, schema);
+    return decoded ? (decoded.rows[0] ?? defaultValue) : safeJsonParse<T>(res, defaultValue);
+}
+
+/**
+ * 解析 userID -> 数值 的映射事件，紧凑格式为 ["c1", key, value, key, value...]
+ */
+export function parseWireMap<T>(res : string, defaultValue : T) : T {
+    if (!isWirePayload(res)) {
+        return safeJsonParse<T>(res, defaultValue);
+    }
+    const payload = safeJsonParse<any[]>(res, [WIRE_TAG]);
+    const result : Record<string, any> = {};
+    for (let i = 1; i + 1 < payload.length; i += 2) {
+        result[payload[i]] = payload[i + 1];
+    }
+    return result as T;
+}
+
+/**
+ * 开启或关闭高频 store 事件的紧凑传输格式，JS 侧解码自动识别两种格式
+ * @param {boolean} compact - 是否启用紧凑格式
+ * @example
+ * import { setBridgeWireFormat } from '@/uni_modules/tuikit-atomic-x/utils/wireCodec';
+ * setBridgeWireFormat(true);
+ */
+export function setBridgeWireFormat(compact : boolean) : void {
+    callUTSFunction("setBridgeWireFormat", { compact });
+}
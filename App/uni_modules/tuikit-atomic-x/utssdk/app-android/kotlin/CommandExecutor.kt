@@ -0,0 +1,122 @@
+package uts.sdk.modules.atomicx.kotlin
+
+import android.util.Log
+import com.google.gson.Gson
+import java.util.concurrent.Executors
+import java.util.concurrent.atomic.AtomicInteger
+
+/**
+ * store 命令执行器：不涉及 UI 的 SDK 调用在专用串行线程上按调用顺序执行，避免排在主线程的布局与动画之后；
+ * 视图相关操作（LiveRenderView、SVGAAnimationView 等）仍在主线程执行。
+ *
+ * 线程约定：
+ * - 命令线程：XxxStore.create(liveID)/LiveListStore.shared() 取实例并调用其命令方法，结果通过 SDK 回调返回，
+ *   回调线程不固定，回调中不修改命令读取的状态（currentLiveID 在命令中提交前写入）
+ * - 主线程：视图操作、observer 的订阅与取消、事件监听的注册与移除（LiveEventDispatcher 非线程安全）
+ * - 命令与 observer 共享的状态需可见于两侧：观众名单窗口大小为 @Volatile，在命令线程写入、在 LiveAudience 编码线程读取
+ */
+object CommandExecutor {
+    private const val TAG = "CommandExecutor"
+
+    // 最近等待耗时的采样数，用于计算 p95
+    private const val WAIT_SAMPLE_COUNT = 256
+
+    // 等待超过该值的命令计入 slowWaitCount
+    private const val SLOW_WAIT_NANOS = 100_000_000L
+
+    private val executor = Executors.newSingleThreadExecutor { runnable ->
+        Thread(runnable, "atomicx-command").apply { isDaemon = true }
+    }
+    private val depth = AtomicInteger(0)
+    private val lock = Any()
+
+    private var maxDepth = 0
+    private var executedCount = 0L
+    private var slowWaitCount = 0L
+    private var totalWaitNanos = 0L
+    private var maxWaitNanos = 0L
+    private var totalRunNanos = 0L
+    private val waitSamples = LongArray(WAIT_SAMPLE_COUNT)
+    private var waitSampleSize = 0
+    private var waitSampleIndex = 0
+
+    /**
+     * 提交命令，按提交顺序串行执行
+     */
+    fun execute(name: String, block: () -> Unit) {
+        val enqueuedAt = System.nanoTime()
+        val current = depth.incrementAndGet()
+        synchronized(lock) {
+            maxDepth = maxOf(maxDepth, current)
+        }
+        executor.execute {
+            val startedAt = System.nanoTime()
+            val startedMicros = if (TraceRecorder.isEnabled) TraceRecorder.nowMicros() else 0L
+            try {
+                block()
+            } catch (e: Exception) {
+                Log.e(TAG, "command $name failed", e)
+            }
+            val run = System.nanoTime() - startedAt
+            record(name, startedAt - enqueuedAt, run)
+            if (startedMicros > 0) {
+                TraceRecorder.complete(
+                    name, "command", TraceRecorder.COMMAND_THREAD_ID, startedMicros, run / 1000,
+                    mapOf("waitMs" to ((startedAt - enqueuedAt) / 1_000_000.0).toString()),
+                )
+            }
+        }
+    }
+
+    /**
+     * 在命令线程上执行状态更新（如 SDK 回调中写入命令读取的状态），不计入命令指标
+     */
+    fun post(block: () -> Unit) {
+        executor.execute {
+            try {
+                block()
+            } catch (e: Exception) {
+                Log.e(TAG, "post failed", e)
+            }
+        }
+    }
+
+    private fun record(name: String, wait: Long, run: Long) {
+        depth.decrementAndGet()
+        synchronized(lock) {
+            executedCount++
+            totalWaitNanos += wait
+            totalRunNanos += run
+            maxWaitNanos = maxOf(maxWaitNanos, wait)
+            if (wait > SLOW_WAIT_NANOS) {
+                slowWaitCount++
+                Log.w(TAG, "slow command: $name, waitMs: ${wait / 1_000_000.0}")
+            }
+            waitSamples[waitSampleIndex] = wait
+            waitSampleIndex = (waitSampleIndex + 1) % WAIT_SAMPLE_COUNT
+            waitSampleSize = minOf(waitSampleSize + 1, WAIT_SAMPLE_COUNT)
+        }
+    }
+
+    fun metrics(): Map<String, Any> {
+        synchronized(lock) {
+            val sorted = waitSamples.copyOf(waitSampleSize).sorted()
+            val p95 = if (sorted.isEmpty()) 0L else sorted[minOf(sorted.size - 1, sorted.size * 95 / 100)]
+            val count = maxOf(executedCount, 1L)
+            return mapOf(
+                "queueDepth" to depth.get(),
+                "maxQueueDepth" to maxDepth,
+                "executedCount" to executedCount,
+                "slowWaitCount" to slowWaitCount,
+                "avgWaitMs" to totalWaitNanos / count / 1_000_000.0,
+                "p95WaitMs" to p95 / 1_000_000.0,
+                "maxWaitMs" to maxWaitNanos / 1_000_000.0,
+                "avgRunMs" to totalRunNanos / count / 1_000_000.0,
+            )
+        }
+    }
+
+    fun metricsJson(): String {
+        return Gson().toJson(metrics())
+    }
+}
@@ -73,10 +73,15 @@ class LiveRenderView(context: Context, attrs: AttributeSet? = null) : Constraint
             Logger.e(TAG + "updateRenderView: liveID is empty")
             return
         }
+        val startedMicros = TraceRecorder.nowMicros()
         removeAllViews()
         val renderView = LiveCoreView(context, null, 0, nativeViewType)
         renderView.setLiveId(liveID)
         val lp = LayoutParams(LayoutParams.MATCH_PARENT, LayoutParams.MATCH_PARENT)
         addView(renderView, lp)
+        TraceRecorder.complete(
+            "renderViewAttach", "view", TraceRecorder.MAIN_THREAD_ID, startedMicros,
+            TraceRecorder.nowMicros() - startedMicros, mapOf("liveID" to liveID, "viewType" to nativeViewType.toString()),
+        )
     }
 }
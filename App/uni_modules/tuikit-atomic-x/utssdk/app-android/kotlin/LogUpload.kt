@@ -0,0 +1,247 @@
+package uts.sdk.modules.atomicx.kotlin
+
+import android.os.Handler
+import android.os.Looper
+import android.util.Log
+import com.tencent.liteav.base.ContextUtils
+import org.json.JSONArray
+import org.json.JSONObject
+import java.io.File
+import java.io.FileInputStream
+import java.io.FileOutputStream
+import java.text.SimpleDateFormat
+import java.util.Date
+import java.util.Locale
+import java.util.concurrent.Executors
+import java.util.zip.ZipEntry
+import java.util.zip.ZipOutputStream
+
+/**
+ * 日志导出：增量维护日志文件索引（大小、时间范围、来源），按时间窗口筛选后在后台线程流式压缩为一个 zip，
+ * 总大小受上限约束。归档内第一个文件为 manifest.json，日志文件按 <source>/<fileName> 存放，与 iOS 端格式一致
+ */
+object LogUpload {
+    private const val TAG = "LogUpload"
+    private const val DEFAULT_MAX_BYTES = 50L * 1024 * 1024
+    private const val ARCHIVE_PREFIX = "atomicx_logs_"
+    private const val CHUNK_SIZE = 64 * 1024
+
+    private class LogSource(val name: String, val directory: File, val extensions: List<String>)
+
+    private class LogFile(val file: File, val source: String) {
+        var size = 0L
+        var startTime = 0L
+        var endTime = 0L
+
+        fun overlaps(from: Long, to: Long): Boolean = endTime >= from && startTime <= to
+
+        fun toJson(): JSONObject = JSONObject()
+            .put("name", file.name)
+            .put("path", file.absolutePath)
+            .put("source", source)
+            .put("size", size)
+            .put("startTime", startTime)
+            .put("endTime", endTime)
+    }
+
+    private val executor = Executors.newSingleThreadExecutor { runnable ->
+        Thread(runnable, "atomicx-logupload").apply { isDaemon = true }
+    }
+    private val mainHandler = Handler(Looper.getMainLooper())
+
+    // 以下状态只在 executor 线程访问
+    private val index = HashMap<String, LogFile>()
+    private val directoryModifiedAt = HashMap<String, Long>()
+    private val directoryFiles = HashMap<String, List<File>>()
+    private var isExporting = false
+
+    /**
+     * 在后台线程刷新索引，回调时间窗口内的日志文件 JSON 数组（按结束时间倒序），时间为毫秒，小于等于 0 表示不限
+     */
+    fun fetchLogFiles(startTime: Long, endTime: Long, completion: (String) -> Unit) {
+        executor.execute {
+            val from = maxOf(startTime, 0L)
+            val to = if (endTime > 0) endTime else Long.MAX_VALUE
+            val files = JSONArray()
+            refreshIndex().filter { it.overlaps(from, to) }.forEach { files.put(it.toJson()) }
+            val json = files.toString()
+            mainHandler.post { completion(json) }
+        }
+    }
+
+    /**
+     * 导出时间窗口内的日志为 zip：按结束时间从新到旧选取，未压缩总大小不超过 maxBytes（小于等于 0 时为 50MB），
+     * 超出的文件记入 manifest 的 skipped。progress 为 0~1，completion 的 code 为 0 时 path 为归档路径
+     */
+    fun exportLogs(
+        startTime: Long,
+        endTime: Long,
+        maxBytes: Long,
+        progress: (Double) -> Unit,
+        completion: (code: Int, message: String, path: String) -> Unit,
+    ) {
+        executor.execute {
+            if (isExporting) {
+                mainHandler.post { completion(-1, "export in progress", "") }
+                return@execute
+            }
+            isExporting = true
+            try {
+                export(startTime, endTime, maxBytes, progress, completion)
+            } finally {
+                isExporting = false
+            }
+        }
+    }
+
+    private fun export(
+        startTime: Long,
+        endTime: Long,
+        maxBytes: Long,
+        progress: (Double) -> Unit,
+        completion: (code: Int, message: String, path: String) -> Unit,
+    ) {
+        val from = maxOf(startTime, 0L)
+        val to = if (endTime > 0) endTime else Long.MAX_VALUE
+        val budget = if (maxBytes > 0) maxBytes else DEFAULT_MAX_BYTES
+        val selected = ArrayList<LogFile>()
+        val skipped = ArrayList<LogFile>()
+        var totalBytes = 0L
+        for (logFile in refreshIndex()) {
+            if (!logFile.overlaps(from, to)) {
+                continue
+            }
+            if (totalBytes + logFile.size > budget) {
+                skipped.add(logFile)
+                continue
+            }
+            selected.add(logFile)
+            totalBytes += logFile.size
+        }
+        if (selected.isEmpty()) {
+            mainHandler.post { completion(-2, "no log files in range", "") }
+            return
+        }
+
+        val archive = newArchiveFile()
+        if (archive == null) {
+            mainHandler.post { completion(-3, "export failed: no cache directory", "") }
+            return
+        }
+        try {
+            ZipOutputStream(FileOutputStream(archive)).use { zip ->
+                val manifest = JSONObject()
+                    .put("version", 1)
+                    .put("platform", "android")
+                    .put("createdAt", System.currentTimeMillis())
+                    .put("startTime", from)
+                    .put("endTime", to)
+                    .put("maxBytes", budget)
+                    .put("files", JSONArray(selected.map { it.toJson() }))
+                    .put("skipped", JSONArray(skipped.map { it.toJson() }))
+                zip.putNextEntry(ZipEntry("manifest.json"))
+                zip.write(manifest.toString().toByteArray(Charsets.UTF_8))
+                zip.closeEntry()
+
+                val buffer = ByteArray(CHUNK_SIZE)
+                var readBytes = 0L
+                var reportedPercent = -1
+                for (logFile in selected) {
+                    val entry = ZipEntry("${logFile.source}/${logFile.file.name}")
+                    entry.time = logFile.endTime
+                    zip.putNextEntry(entry)
+                    FileInputStream(logFile.file).use { input ->
+                        while (true) {
+                            val count = input.read(buffer)
+                            if (count < 0) {
+                                break
+                            }
+                            zip.write(buffer, 0, count)
+                            readBytes += count
+                            val percent = minOf(readBytes * 100 / maxOf(totalBytes, 1L), 100L).toInt()
+                            if (percent != reportedPercent) {
+                                reportedPercent = percent
+                                mainHandler.post { progress(percent / 100.0) }
+                            }
+                        }
+                    }
+                    zip.closeEntry()
+                }
+            }
+            Log.i(TAG, "exported: ${archive.absolutePath}, files: ${selected.size}, skipped: ${skipped.size}")
+            mainHandler.post { completion(0, "", archive.absolutePath) }
+        } catch (e: Exception) {
+            archive.delete()
+            mainHandler.post { completion(-3, "export failed: $e", "") }
+        }
+    }
+
+    private fun logSources(): List<LogSource> {
+        val filesDir = ContextUtils.getApplicationContext()?.getExternalFilesDir(null) ?: return emptyList()
+        return listOf(
+            LogSource("liteav", File(filesDir, "log/liteav"), listOf(".clog", ".xlog")),
+            LogSource("imsdk", File(filesDir, "log/tencent/imsdk"), listOf(".xlog")),
+        )
+    }
+
+    /**
+     * 增量刷新索引：目录修改时间未变时不重新列目录，文件大小与修改时间未变时复用已有条目。只在 executor 线程调用
+     */
+    private fun refreshIndex(): List<LogFile> {
+        val alive = HashSet<String>()
+        for (source in logSources()) {
+            val directoryPath = source.directory.absolutePath
+            val directoryModified = source.directory.lastModified()
+            var files = directoryFiles[directoryPath]
+            if (files == null || directoryModified != directoryModifiedAt[directoryPath]) {
+                files = source.directory.listFiles { file ->
+                    file.isFile && source.extensions.any { file.name.endsWith(it) }
+                }?.toList() ?: emptyList()
+                directoryFiles[directoryPath] = files
+                directoryModifiedAt[directoryPath] = directoryModified
+            }
+            for (file in files) {
+                val path = file.absolutePath
+                val size = file.length()
+                val endTime = file.lastModified()
+                if (endTime == 0L) {
+                    continue
+                }
+                alive.add(path)
+                val cached = index[path]
+                if (cached != null && cached.size == size && cached.endTime == endTime) {
+                    continue
+                }
+                val logFile = cached ?: LogFile(file, source.name)
+                logFile.size = size
+                logFile.startTime = minOf(parseStartTime(file.name) ?: endTime, endTime)
+                logFile.endTime = endTime
+                index[path] = logFile
+            }
+        }
+        index.keys.retainAll(alive)
+        return index.values.sortedByDescending { it.endTime }
+    }
+
+    /**
+     * Android 文件没有可靠的创建时间，起始时间取文件名中的日期（如 LiteAV_C_20250820-19243.clog）
+     */
+    private fun parseStartTime(fileName: String): Long? {
+        val date = Regex("(20\\d{6})").find(fileName)?.value ?: return null
+        return try {
+            SimpleDateFormat("yyyyMMdd", Locale.US).parse(date)?.time
+        } catch (e: Exception) {
+            null
+        }
+    }
+
+    /**
+     * 归档放在缓存目录，生成新归档前删除之前导出的归档
+     */
+    private fun newArchiveFile(): File? {
+        val cacheDir = ContextUtils.getApplicationContext()?.cacheDir ?: return null
+        cacheDir.listFiles { file -> file.name.startsWith(ARCHIVE_PREFIX) }?.forEach { it.delete() }
+        val name = SimpleDateFormat("yyyyMMdd-HHmmss", Locale.US).format(Date())
+        return File(cacheDir, "$ARCHIVE_PREFIX$name.zip")
+    }
+}
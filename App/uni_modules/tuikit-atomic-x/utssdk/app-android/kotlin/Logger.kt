@@ -1,13 +1,26 @@
 package uts.sdk.modules.atomicx.kotlin
 
+import android.content.Context
 import android.util.Log
 import com.tencent.liteav.base.ContextUtils
 import com.tencent.trtc.TRTCCloud
 import org.json.JSONException
 import org.json.JSONObject
+import java.util.concurrent.Executors
+import java.util.concurrent.TimeUnit
+import java.util.concurrent.atomic.AtomicBoolean
+import java.util.concurrent.atomic.AtomicLong
+import java.util.concurrent.atomic.AtomicLongArray
+import java.util.concurrent.atomic.AtomicReferenceArray
 
+/**
+ * 写入 TRTC 日志文件的插件日志。调用线程只把记录放入无锁环形缓冲区，由后台线程批量写入；
+ * 调用位置（文件、行号）只在 warning 及以上级别采集一次。缓冲区满时丢弃新记录并计数，
+ * 下次写入时补一条丢弃条数的告警
+ */
 class Logger {
     companion object {
+        private const val TAG = "Logger"
         private const val API = "TuikitLog"
         private const val LOG_KEY_API = "api"
         private const val LOG_KEY_PARAMS = "params"
@@ -20,60 +33,186 @@ class Logger {
         private const val LOG_LEVEL_INFO = 0
         private const val LOG_LEVEL_WARNING = 1
         private const val LOG_LEVEL_ERROR = 2
-        private const val LOG_FUNCTION_CALLER_INDEX = 5
+
+        // 环形缓冲区容量，必须为 2 的幂
+        private const val BUFFER_CAPACITY = 1024
+
+        // 单次写入合并的 info 记录条数与字符数上限
+        private const val BATCH_MAX_RECORDS = 32
+        private const val BATCH_MAX_CHARS = 8 * 1024
+        private const val FLUSH_DELAY_MS = 100L
+
+        private val buffer = RecordRingBuffer(BUFFER_CAPACITY)
+        private val droppedCount = AtomicLong(0)
+        private val flushScheduled = AtomicBoolean(false)
+        private val immediateFlushScheduled = AtomicBoolean(false)
+        private val flushExecutor = Executors.newSingleThreadScheduledExecutor { runnable ->
+            Thread(runnable, "atomicx-logger").apply { isDaemon = true }
+        }
+
+        // 只在写入线程访问
+        private var context: Context? = null
+        private var reportedDropCount = 0L
 
         fun i(message: String) {
-            log(LOG_LEVEL_INFO, message)
+            enqueue(Record(LOG_LEVEL_INFO, message, "", 0))
         }
 
         fun w(message: String) {
-            log(LOG_LEVEL_WARNING, message)
+            val caller = findCaller()
+            enqueue(Record(LOG_LEVEL_WARNING, message, caller?.fileName ?: "", caller?.lineNumber ?: 0))
         }
 
         fun e(message: String) {
-            log(LOG_LEVEL_ERROR, message)
+            val caller = findCaller()
+            enqueue(Record(LOG_LEVEL_ERROR, message, caller?.fileName ?: "", caller?.lineNumber ?: 0))
         }
 
-        private fun log(
-            level: Int,
-            message: String,
-        ) {
-            var context = ContextUtils.getApplicationContext()
-            if (context == null) {
-                ContextUtils.initContextFromNative("liteav")
-                context = ContextUtils.getApplicationContext()
+        /**
+         * 因缓冲区满被丢弃的记录数
+         */
+        fun droppedCount(): Long = droppedCount.get()
+
+        private fun enqueue(record: Record) {
+            if (!buffer.offer(record)) {
+                droppedCount.incrementAndGet()
+            }
+            if (record.level == LOG_LEVEL_INFO) {
+                if (flushScheduled.compareAndSet(false, true)) {
+                    flushExecutor.schedule({ flush() }, FLUSH_DELAY_MS, TimeUnit.MILLISECONDS)
+                }
+            } else if (immediateFlushScheduled.compareAndSet(false, true)) {
+                // 不等待已排期的 info 延迟写入，warning 及以上立即写入（连同缓冲区中之前的 info）
+                flushExecutor.execute { flush() }
+            }
+        }
+
+        /**
+         * 调用位置：跳过 Logger 与插件 BridgeLogger 自身的栈帧，只遍历一次调用栈
+         */
+        private fun findCaller(): StackTraceElement? {
+            return Throwable().stackTrace.firstOrNull { element ->
+                !element.className.startsWith(Logger::class.java.name) && !element.className.contains("BridgeLogger")
+            }
+        }
+
+        private fun flush() {
+            flushScheduled.set(false)
+            immediateFlushScheduled.set(false)
+            val trtcCloud = resolveTRTCCloud() ?: return
+            val dropped = droppedCount.get()
+            if (dropped != reportedDropCount) {
+                send(trtcCloud, LOG_LEVEL_WARNING, "Logger buffer full, dropped ${dropped - reportedDropCount} records", "", 0)
+                reportedDropCount = dropped
             }
+            val batch = StringBuilder()
+            var batchSize = 0
+            while (true) {
+                val record = buffer.poll() ?: break
+                if (record.level != LOG_LEVEL_INFO) {
+                    if (batchSize > 0) {
+                        send(trtcCloud, LOG_LEVEL_INFO, batch.toString(), "", 0)
+                        batch.setLength(0)
+                        batchSize = 0
+                    }
+                    send(trtcCloud, record.level, record.message, record.file, record.line)
+                    continue
+                }
+                if (batchSize > 0) {
+                    batch.append('\n')
+                }
+                batch.append(record.message)
+                batchSize++
+                if (batchSize >= BATCH_MAX_RECORDS || batch.length >= BATCH_MAX_CHARS) {
+                    send(trtcCloud, LOG_LEVEL_INFO, batch.toString(), "", 0)
+                    batch.setLength(0)
+                    batchSize = 0
+                }
+            }
+            if (batchSize > 0) {
+                send(trtcCloud, LOG_LEVEL_INFO, batch.toString(), "", 0)
+            }
+        }
+
+        private fun resolveTRTCCloud(): TRTCCloud? {
             if (context == null) {
-                return
+                context = ContextUtils.getApplicationContext()
+                if (context == null) {
+                    ContextUtils.initContextFromNative("liteav")
+                    context = ContextUtils.getApplicationContext()
+                }
             }
+            return context?.let { TRTCCloud.sharedInstance(it) }
+        }
+
+        private fun send(trtcCloud: TRTCCloud, level: Int, message: String, file: String, line: Int) {
             try {
                 val paramsJson = JSONObject()
                 paramsJson.put(LOG_KEY_PARAMS_LEVEL, level)
                 paramsJson.put(LOG_KEY_PARAMS_MESSAGE, message)
                 paramsJson.put(LOG_KEY_PARAMS_MODULE, LOG_VALUE_PARAMS_MODULE)
-                paramsJson.put(LOG_KEY_PARAMS_FILE, getCallerFileName())
-                paramsJson.put(LOG_KEY_PARAMS_LINE, getCallerLineNumber())
+                paramsJson.put(LOG_KEY_PARAMS_FILE, file)
+                paramsJson.put(LOG_KEY_PARAMS_LINE, line)
 
                 val loggerJson = JSONObject()
                 loggerJson.put(LOG_KEY_API, API)
                 loggerJson.put(LOG_KEY_PARAMS, paramsJson)
 
-                TRTCCloud.sharedInstance(context).callExperimentalAPI(loggerJson.toString())
+                trtcCloud.callExperimentalAPI(loggerJson.toString())
             } catch (e: JSONException) {
-                Log.e("Logger", e.toString())
+                Log.e(TAG, e.toString())
             }
         }
+    }
 
-        private fun getCallerFileName(): String {
-            val stackTrace = Thread.currentThread().stackTrace
-            if (stackTrace.size < LOG_FUNCTION_CALLER_INDEX + 1) return ""
-            return stackTrace[LOG_FUNCTION_CALLER_INDEX].fileName
+    private class Record(val level: Int, val message: String, val file: String, val line: Int)
+
+    /**
+     * 有界多生产者、单消费者环形缓冲区：每个槽位带序号，生产者用 CAS 占位，消费者只在写入线程上读取
+     */
+    private class RecordRingBuffer(private val capacity: Int) {
+        private val mask = capacity - 1
+        private val slots = AtomicReferenceArray<Record?>(capacity)
+        private val sequences = AtomicLongArray(capacity)
+        private val tail = AtomicLong(0)
+        private var head = 0L
+
+        init {
+            for (i in 0 until capacity) {
+                sequences.set(i, i.toLong())
+            }
         }
 
-        private fun getCallerLineNumber(): Int {
-            val stackTrace = Thread.currentThread().stackTrace
-            if (stackTrace.size < LOG_FUNCTION_CALLER_INDEX + 1) return 0
-            return stackTrace[LOG_FUNCTION_CALLER_INDEX].lineNumber
+        /**
+         * 放入记录，缓冲区满时返回 false
+         */
+        fun offer(record: Record): Boolean {
+            while (true) {
+                val position = tail.get()
+                val index = (position and mask.toLong()).toInt()
+                val diff = sequences.get(index) - position
+                if (diff == 0L) {
+                    if (tail.compareAndSet(position, position + 1)) {
+                        slots.set(index, record)
+                        sequences.set(index, position + 1)
+                        return true
+                    }
+                } else if (diff < 0L) {
+                    return false
+                }
+            }
+        }
+
+        fun poll(): Record? {
+            val index = (head and mask.toLong()).toInt()
+            if (sequences.get(index) != head + 1) {
+                return null
+            }
+            val record = slots.get(index)
+            slots.set(index, null)
+            sequences.set(index, head + capacity)
+            head++
+            return record
         }
     }
 }
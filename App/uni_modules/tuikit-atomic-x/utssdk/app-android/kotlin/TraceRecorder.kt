@@ -0,0 +1,108 @@
+package uts.sdk.modules.atomicx.kotlin
+
+import org.json.JSONArray
+import org.json.JSONObject
+
+/**
+ * 链路追踪：native 侧的命令执行、store 首次下发、渲染视图挂载写入固定大小的环形缓冲区，
+ * 由 JS 侧合并导出为 Chrome trace_event JSON。时间戳为 Unix 微秒，与 JS 侧对齐
+ */
+object TraceRecorder {
+    // 环形缓冲区容量，写满后覆盖最旧的事件
+    private const val CAPACITY = 2048
+
+    // trace_event 中的线程编号，按事件来源区分
+    const val MAIN_THREAD_ID = 1
+    const val COMMAND_THREAD_ID = 2
+    const val STORE_THREAD_ID = 3
+
+    private class TraceEvent(
+        val name: String,
+        val category: String,
+        val phase: String,
+        val timestamp: Long,
+        val duration: Long,
+        val threadID: Int,
+        val args: Map<String, String>,
+    )
+
+    @Volatile
+    var isEnabled = true
+        private set
+
+    private val events = arrayOfNulls<TraceEvent>(CAPACITY)
+    private var size = 0
+    private var nextIndex = 0
+
+    fun nowMicros(): Long = System.currentTimeMillis() * 1000
+
+    fun setEnabled(enabled: Boolean) {
+        isEnabled = enabled
+    }
+
+    /**
+     * 记录有起止时间的事件（ph = X）
+     */
+    fun complete(
+        name: String,
+        category: String,
+        threadID: Int,
+        startMicros: Long,
+        durationMicros: Long,
+        args: Map<String, String> = emptyMap(),
+    ) {
+        if (!isEnabled) return
+        append(TraceEvent(name, category, "X", startMicros, durationMicros, threadID, args))
+    }
+
+    /**
+     * 记录瞬时事件（ph = i）
+     */
+    fun instant(name: String, category: String, threadID: Int, args: Map<String, String> = emptyMap()) {
+        if (!isEnabled) return
+        append(TraceEvent(name, category, "i", nowMicros(), 0, threadID, args))
+    }
+
+    @Synchronized
+    fun clear() {
+        events.fill(null)
+        size = 0
+        nextIndex = 0
+    }
+
+    /**
+     * 按时间先后导出 trace_event 数组（不含 pid，由 JS 侧合并时填写）
+     */
+    fun eventsJson(): String {
+        val ordered = synchronized(this) {
+            val start = if (size < CAPACITY) 0 else nextIndex
+            (0 until size).map { events[(start + it) % CAPACITY]!! }
+        }
+        val array = JSONArray()
+        for (event in ordered) {
+            val item = JSONObject()
+                .put("name", event.name)
+                .put("cat", event.category)
+                .put("ph", event.phase)
+                .put("ts", event.timestamp)
+                .put("tid", event.threadID)
+                .put("args", JSONObject(event.args))
+            if (event.phase == "X") {
+                item.put("dur", event.duration)
+            } else {
+                item.put("s", "t")
+            }
+            array.put(item)
+        }
+        return array.toString()
+    }
+
+    @Synchronized
+    private fun append(event: TraceEvent) {
+        events[nextIndex] = event
+        nextIndex = (nextIndex + 1) % CAPACITY
+        if (size < CAPACITY) {
+            size++
+        }
+    }
+}
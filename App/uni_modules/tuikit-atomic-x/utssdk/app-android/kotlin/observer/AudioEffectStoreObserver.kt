@@ -3,38 +3,49 @@ package uts.sdk.modules.atomicx.observer
 import com.google.gson.Gson
 import io.trtc.tuikit.atomicxcore.api.AudioEffectStore
 import kotlinx.coroutines.CoroutineScope
-import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.launch
 
 object AudioEffectStoreObserver {
     private val gson = Gson()
     private var bindDataJob: Job? = null
+    /**
+     * 取消 store 状态订阅，由 JS 侧订阅引用计数归零时调用
+     */
+    fun unsubscribe() {
+        bindDataJob?.cancel()
+        bindDataJob = null
+    }
+
     fun audioEffectStoreChanged(callback: (String, String) -> Unit) {
         bindDataJob?.cancel()
-        bindDataJob = CoroutineScope(Dispatchers.Main).launch {
+        val callback = BridgeDeduplicator.distinctCallback(
+            "AudioEffect",
+            BridgeEncoder.mainThreadCallback("AudioEffect", callback),
+        )
+        bindDataJob = CoroutineScope(BridgeEncoder.dispatcher("AudioEffect")).launch {
             launch {
                 AudioEffectStore.shared().audioEffectState.isEarMonitorOpened
                     .collect { enable ->
-                        callback("isEarMonitorOpened", gson.toJson(enable))
+                        callback("isEarMonitorOpened", gson.toBridgeJson(enable))
                     }
             }
             launch {
                 AudioEffectStore.shared().audioEffectState.earMonitorVolume
                     .collect { volume ->
-                        callback("earMonitorVolume", gson.toJson(volume))
+                        callback("earMonitorVolume", gson.toBridgeJson(volume))
                     }
             }
             launch {
                 AudioEffectStore.shared().audioEffectState.audioChangerType
                     .collect { type ->
-                        callback("audioChangerType", gson.toJson(type.value))
+                        callback("audioChangerType", gson.toBridgeJson(type.value))
                     }
             }
             launch {
                 AudioEffectStore.shared().audioEffectState.audioReverbType
                     .collect { type ->
-                        callback("audioReverbType", gson.toJson(type.value))
+                        callback("audioReverbType", gson.toBridgeJson(type.value))
                     }
             }
         }
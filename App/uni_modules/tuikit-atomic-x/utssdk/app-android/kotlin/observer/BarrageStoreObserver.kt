@@ -3,30 +3,101 @@ package uts.sdk.modules.atomicx.observer
 import com.google.gson.Gson
 import io.trtc.tuikit.atomicxcore.api.Barrage
 import io.trtc.tuikit.atomicxcore.api.BarrageStore
-import io.trtc.tuikit.atomicxcore.api.BarrageType
 import kotlinx.coroutines.CoroutineScope
-import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.launch
 
 object BarrageStoreObserver {
     private val gson = Gson()
-    private var bindDataJob: Job? = null
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private val roomJobs = HashMap<String, Job>()
+
+    // 单个直播间已同步到 JS 侧的最后一条消息序列号及列表长度，用于计算增量；只在 Barrage 编码线程上读写
+    private class SyncProgress {
+        var lastSyncedSequence: Long? = null
+        var lastSyncedCount = 0
+    }
+
+    /**
+     * 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+     */
+    fun unsubscribe(liveID: String) {
+        roomJobs.remove(liveID)?.cancel()
+    }
 
     fun barrageStoreChanged(liveID: String, callback: (String, String) -> Unit) {
-        bindDataJob?.cancel()
-        bindDataJob = CoroutineScope(Dispatchers.Main).launch {
+        roomJobs.remove(liveID)?.cancel()
+        val callback = BridgeDeduplicator.distinctCallback(
+            "Barrage",
+            liveID,
+            BridgeEncoder.mainThreadCallback("Barrage", callback),
+        )
+        roomJobs[liveID] = CoroutineScope(BridgeEncoder.dispatcher("Barrage")).launch {
+            val progress = SyncProgress()
             launch {
                 BarrageStore.create(liveID).barrageState.messageList.collect { messageList ->
-                    callback("messageList", gson.toJson(messageList))
+                    syncMessageList(messageList, progress, callback)
                 }
             }
             // TODO: 底层未实现，暂时隐藏
             // launch {
             //     BarrageStore.create(liveID).barrageState.allowSendMessage.collect { allowSendMessage ->
-            //         callback("allowSendMessage", gson.toJson(allowSendMessage))
+            //         callback("allowSendMessage", gson.toBridgeJson(allowSendMessage))
             //     }
             // }
         }
     }
+
+    /**
+     * 只下发上次同步之后追加的消息；找不到上次同步位置时（首次订阅、store 重新同步）下发全量 reset
+     */
+    private fun syncMessageList(
+        messageList: List<Barrage>,
+        progress: SyncProgress,
+        callback: (String, String) -> Unit,
+    ) {
+        val lastSequence = progress.lastSyncedSequence
+        val lastIndex = if (lastSequence == null) -1 else messageList.indexOfLast { it.sequence == lastSequence }
+        val previousCount = progress.lastSyncedCount
+        progress.lastSyncedSequence = messageList.lastOrNull()?.sequence
+        progress.lastSyncedCount = messageList.size
+
+        if (lastIndex < 0) {
+            val senders = internSenders(messageList, callback)
+            callback("messageListReset", ModelEncoder.encodeList(messageList.indices.toList()) {
+                writeBarrage(messageList[it], senders?.get(it))
+            })
+            return
+        }
+        val appended = messageList.subList(lastIndex + 1, messageList.size)
+        if (appended.isEmpty() && messageList.size == previousCount) {
+            return
+        }
+        val senders = internSenders(appended, callback)
+        val json = if (WireSchema.isEnabled) {
+            ModelEncoder.encodeList(appended.indices.toList(), true, listOf(messageList.size.toLong())) {
+                writeBarrage(appended[it], senders?.get(it))
+            }
+        } else {
+            ModelEncoder.encode(false) {
+                beginMap()
+                name("total").value(messageList.size)
+                name("messages").beginArray()
+                appended.forEachIndexed { i, barrage -> writeBarrage(barrage, senders?.get(i)) }
+                endArray()
+                endMap()
+            }
+        }
+        callback("messageListAppend", json)
+    }
+
+    /**
+     * 开启用户资料驻留时返回每条消息 sender 的句柄，资料由 UserInternTable 通过 userProfiles 先行下发
+     */
+    private fun internSenders(messages: List<Barrage>, callback: (String, String) -> Unit): List<Int>? {
+        if (!UserInternTable.isEnabled) {
+            return null
+        }
+        return UserInternTable.intern(messages.map { it.sender }, callback)
+    }
 }
@@ -3,7 +3,6 @@ package uts.sdk.modules.atomicx.observer
 import com.google.gson.Gson
 import io.trtc.tuikit.atomicxcore.api.BaseBeautyStore
 import kotlinx.coroutines.CoroutineScope
-import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.launch
 
@@ -11,22 +10,34 @@ object BaseBeautyStoreObserver {
     private val gson = Gson()
     private var bindDataJob: Job? = null
 
+    /**
+     * 取消 store 状态订阅，由 JS 侧订阅引用计数归零时调用
+     */
+    fun unsubscribe() {
+        bindDataJob?.cancel()
+        bindDataJob = null
+    }
+
     fun beautyStoreChanged(callback: (String, String) -> Unit) {
         bindDataJob?.cancel()
-        bindDataJob = CoroutineScope(Dispatchers.Main).launch {
+        val callback = BridgeDeduplicator.distinctCallback(
+            "BaseBeauty",
+            BridgeEncoder.mainThreadCallback("BaseBeauty", callback),
+        )
+        bindDataJob = CoroutineScope(BridgeEncoder.dispatcher("BaseBeauty")).launch {
             launch {
                 BaseBeautyStore.shared().baseBeautyState.smoothLevel.collect { level ->
-                    callback("smoothLevel", gson.toJson(level))
+                    callback("smoothLevel", gson.toBridgeJson(level))
                 }
             }
             launch {
                 BaseBeautyStore.shared().baseBeautyState.whitenessLevel.collect { level ->
-                    callback("whitenessLevel", gson.toJson(level))
+                    callback("whitenessLevel", gson.toBridgeJson(level))
                 }
             }
             launch {
                 BaseBeautyStore.shared().baseBeautyState.ruddyLevel.collect { level ->
-                    callback("ruddyLevel", gson.toJson(level))
+                    callback("ruddyLevel", gson.toBridgeJson(level))
                 }
             }
         }
@@ -0,0 +1,77 @@
+package uts.sdk.modules.atomicx.observer
+
+import uts.sdk.modules.atomicx.kotlin.TraceRecorder
+import java.util.concurrent.ConcurrentHashMap
+import java.util.concurrent.atomic.AtomicLong
+
+/**
+ * store 事件去重：按 (store, liveID, key) 记录上一次下发数据的哈希，相同数据不再切回主线程下发
+ */
+object BridgeDeduplicator {
+    /**
+     * 增量事件不是状态快照，相同内容也需要下发；value 为对应的全量 key（没有时为 null）。
+     * 增量下发后 JS 侧状态已不等于上一次全量，清掉全量 key 的哈希，使之后内容相同的全量仍会下发
+     */
+    private val deltaKeys = mapOf(
+        "messageListAppend" to "messageListReset",
+        "audienceListDelta" to "audienceList",
+        "seatListPatch" to "seatList",
+        "userProfiles" to null,
+    )
+
+    private val suppressedCounts = ConcurrentHashMap<String, AtomicLong>()
+    private val suppressedTotal = AtomicLong(0)
+
+    /**
+     * 包装一次订阅的回调：去重状态随包装实例创建，重新订阅（bindDataJob 重新 launch 回放当前值）时当前值会重新下发且只下发一次
+     */
+    fun distinctCallback(store: String, liveID: String = "", callback: (String, String) -> Unit): (String, String) -> Unit {
+        val lastHashes = HashMap<String, Long>()
+        val emittedKeys = HashSet<String>()
+        return { name, data ->
+            if (TraceRecorder.isEnabled && synchronized(emittedKeys) { emittedKeys.add(name) }) {
+                // 每个订阅的每个 key 只记录首次下发，用于对齐 JS 侧的首次渲染
+                TraceRecorder.instant(
+                    "first $store.$name", "store", TraceRecorder.STORE_THREAD_ID, mapOf("liveID" to liveID),
+                )
+            }
+            if (deltaKeys.containsKey(name)) {
+                deltaKeys[name]?.let { baseKey -> synchronized(lastHashes) { lastHashes.remove(baseKey) } }
+                callback(name, data)
+            } else {
+                val hash = hash64(data)
+                val isDuplicate = synchronized(lastHashes) { lastHashes.put(name, hash) == hash }
+                if (isDuplicate) {
+                    recordSuppressed(store, liveID, name)
+                    BridgeMetrics.recordSuppressed(store, name)
+                } else {
+                    callback(name, data)
+                }
+            }
+        }
+    }
+
+    fun metrics(): Map<String, Any> {
+        return mapOf(
+            "suppressedTotal" to suppressedTotal.get(),
+            "suppressed" to suppressedCounts.mapValues { it.value.get() },
+        )
+    }
+
+    private fun recordSuppressed(store: String, liveID: String, key: String) {
+        val id = if (liveID.isEmpty()) "$store.$key" else "$store.$liveID.$key"
+        suppressedCounts.getOrPut(id) { AtomicLong(0) }.incrementAndGet()
+        suppressedTotal.incrementAndGet()
+    }
+
+    /**
+     * 64 位 FNV-1a，避免 32 位 hashCode 碰撞导致真实变化被丢弃
+     */
+    private fun hash64(data: String): Long {
+        var hash = -0x340d631b7bdddcdbL
+        for (c in data) {
+            hash = (hash xor c.code.toLong()) * 0x100000001b3L
+        }
+        return hash xor data.length.toLong()
+    }
+}
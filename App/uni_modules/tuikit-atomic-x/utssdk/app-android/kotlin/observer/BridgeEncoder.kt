@@ -0,0 +1,91 @@
+package uts.sdk.modules.atomicx.observer
+
+import android.os.Handler
+import android.os.Looper
+import com.google.gson.Gson
+import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.ExperimentalCoroutinesApi
+import java.util.concurrent.ConcurrentHashMap
+import java.util.concurrent.atomic.AtomicLong
+
+/**
+ * store 事件的编码阶段：每个 store 一个串行的后台 dispatcher 完成转换与序列化，只在回调 UTS 时切回主线程
+ */
+object BridgeEncoder {
+    private val dispatchers = ConcurrentHashMap<String, CoroutineDispatcher>()
+    private val mainHandler = Handler(Looper.getMainLooper())
+
+    private val mainThreadEncodeNanos = AtomicLong(0)
+    private val backgroundEncodeNanos = AtomicLong(0)
+    private val mainThreadEncodeCount = AtomicLong(0)
+    private val backgroundEncodeCount = AtomicLong(0)
+
+    /**
+     * 获取 store 对应的串行 dispatcher，同一 store 的事件按到达顺序编码和下发
+     */
+    @OptIn(ExperimentalCoroutinesApi::class)
+    fun dispatcher(store: String): CoroutineDispatcher {
+        return dispatchers.getOrPut(store) { Dispatchers.Default.limitedParallelism(1) }
+    }
+
+    /**
+     * 包装 UTS 回调：在后台调用时 post 到主线程执行，主线程消息队列的 FIFO 保证同一 store 的事件顺序不变。
+     * 位于去重与限频之后，在这里记录的才是实际下发的事件
+     */
+    fun mainThreadCallback(store: String, callback: (String, String) -> Unit): (String, String) -> Unit {
+        return { name, data ->
+            BridgeMetrics.recordEmission(store, name, data)
+            if (isMainThread()) {
+                callback(name, data)
+            } else {
+                mainHandler.post { callback(name, data) }
+            }
+        }
+    }
+
+    /**
+     * 记录一次序列化耗时，按是否在主线程分别累计
+     */
+    fun recordEncode(nanos: Long, onMainThread: Boolean) {
+        BridgeMetrics.recordEncode(nanos)
+        if (onMainThread) {
+            mainThreadEncodeNanos.addAndGet(nanos)
+            mainThreadEncodeCount.incrementAndGet()
+        } else {
+            backgroundEncodeNanos.addAndGet(nanos)
+            backgroundEncodeCount.incrementAndGet()
+        }
+    }
+
+    fun metrics(): Map<String, Any> {
+        return mapOf(
+            "mainThreadEncodeMs" to mainThreadEncodeNanos.get() / 1_000_000.0,
+            "mainThreadEncodeCount" to mainThreadEncodeCount.get(),
+            "backgroundEncodeMs" to backgroundEncodeNanos.get() / 1_000_000.0,
+            "backgroundEncodeCount" to backgroundEncodeCount.get(),
+            "coalescedEventCount" to BridgeRateLimiter.coalescedEventCount(),
+            "dedup" to BridgeDeduplicator.metrics(),
+        )
+    }
+
+    fun metricsJson(): String {
+        return Gson().toJson(metrics())
+    }
+
+    fun isMainThread(): Boolean {
+        return Looper.myLooper() == Looper.getMainLooper()
+    }
+}
+
+/**
+ * 带耗时统计的序列化，observer 中下发给 UTS 的数据统一经过这里
+ */
+fun Gson.toBridgeJson(src: Any?): String {
+    val start = System.nanoTime()
+    try {
+        return toJson(src)
+    } finally {
+        BridgeEncoder.recordEncode(System.nanoTime() - start, BridgeEncoder.isMainThread())
+    }
+}
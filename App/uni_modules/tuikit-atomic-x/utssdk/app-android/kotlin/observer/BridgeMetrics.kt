@@ -0,0 +1,170 @@
+package uts.sdk.modules.atomicx.observer
+
+import com.google.gson.Gson
+
+/**
+ * bridge 指标：按 (store, key) 统计下发频率、编码后字节数与 native 编码耗时，保留最近样本计算滚动分位数。
+ * count/频率/字节数只统计实际切回主线程下发的事件，被去重丢弃与被限频合并的事件分别计入 suppressed 与 coalesced。
+ * 默认关闭，关闭时每次下发只多一次布尔判断
+ */
+object BridgeMetrics {
+    // 每个 (store, key) 保留的最近样本数
+    private const val SAMPLE_COUNT = 128
+
+    @Volatile
+    var isEnabled = false
+        private set
+
+    private val stats = HashMap<String, KeyStats>()
+    private var startedAt = System.nanoTime()
+    private val pendingEncodeNanos = ThreadLocal<LongArray>()
+
+    fun setEnabled(enabled: Boolean) {
+        synchronized(stats) {
+            if (enabled && !isEnabled) {
+                stats.clear()
+                startedAt = System.nanoTime()
+            }
+            isEnabled = enabled
+        }
+    }
+
+    /**
+     * 累计当前线程上的编码耗时，由随后在同一线程上的 recordEmission 归到对应的 key
+     */
+    fun recordEncode(nanos: Long) {
+        if (!isEnabled) {
+            return
+        }
+        val pending = pendingEncodeNanos.get() ?: LongArray(1).also { pendingEncodeNanos.set(it) }
+        pending[0] += nanos
+    }
+
+    /**
+     * 记录一次 store 事件下发（已通过去重与限频，即将切回主线程）
+     */
+    fun recordEmission(store: String, key: String, data: String) {
+        if (!isEnabled) {
+            return
+        }
+        val encodeNanos = takeEncodeNanos()
+        val now = System.nanoTime()
+        val byteCount = data.toByteArray(Charsets.UTF_8).size
+        synchronized(stats) {
+            stats.getOrPut("$store.$key") { KeyStats() }.record(now, byteCount, encodeNanos)
+        }
+    }
+
+    /**
+     * 记录一次因与上次内容相同被去重丢弃的事件，编码耗时仍计入该 key
+     */
+    fun recordSuppressed(store: String, key: String) {
+        recordDropped(store, key, coalesced = false)
+    }
+
+    /**
+     * 记录一次被限频合并（被更新的值覆盖、不会下发）的事件
+     */
+    fun recordCoalesced(store: String, key: String) {
+        recordDropped(store, key, coalesced = true)
+    }
+
+    private fun recordDropped(store: String, key: String, coalesced: Boolean) {
+        if (!isEnabled) {
+            return
+        }
+        val encodeNanos = takeEncodeNanos()
+        synchronized(stats) {
+            stats.getOrPut("$store.$key") { KeyStats() }.recordDropped(encodeNanos, coalesced)
+        }
+    }
+
+    private fun takeEncodeNanos(): Long {
+        val pending = pendingEncodeNanos.get() ?: return 0L
+        val nanos = pending[0]
+        pending[0] = 0L
+        return nanos
+    }
+
+    fun metrics(): Map<String, Any> {
+        synchronized(stats) {
+            return mapOf(
+                "enabled" to isEnabled,
+                "elapsedMs" to (System.nanoTime() - startedAt) / 1_000_000.0,
+                "keys" to stats.mapValues { it.value.snapshot() },
+            )
+        }
+    }
+
+    fun metricsJson(): String {
+        return Gson().toJson(metrics())
+    }
+
+    /**
+     * 单个 (store, key) 的累计值与最近样本环
+     */
+    private class KeyStats {
+        private var count = 0L
+        private var suppressed = 0L
+        private var coalesced = 0L
+        private var totalBytes = 0L
+        private var totalEncodeNanos = 0L
+        private val times = LongArray(SAMPLE_COUNT)
+        private val bytes = LongArray(SAMPLE_COUNT)
+        private val encodeNanos = LongArray(SAMPLE_COUNT)
+        private var size = 0
+        private var index = 0
+
+        fun record(time: Long, byteCount: Int, nanos: Long) {
+            count++
+            totalBytes += byteCount
+            totalEncodeNanos += nanos
+            times[index] = time
+            bytes[index] = byteCount.toLong()
+            encodeNanos[index] = nanos
+            index = (index + 1) % SAMPLE_COUNT
+            size = minOf(size + 1, SAMPLE_COUNT)
+        }
+
+        fun recordDropped(nanos: Long, isCoalesced: Boolean) {
+            if (isCoalesced) coalesced++ else suppressed++
+            totalEncodeNanos += nanos
+        }
+
+        fun snapshot(): Map<String, Any> {
+            val sortedBytes = bytes.copyOf(size).sorted()
+            val sortedEncode = encodeNanos.copyOf(size).sorted()
+            return mapOf(
+                "count" to count,
+                "suppressed" to suppressed,
+                "coalesced" to coalesced,
+                "ratePerSec" to rate(),
+                "totalBytes" to totalBytes,
+                "bytesP50" to percentile(sortedBytes, 50),
+                "bytesP95" to percentile(sortedBytes, 95),
+                "encodeMs" to totalEncodeNanos / 1_000_000.0,
+                "encodeP50Ms" to percentile(sortedEncode, 50) / 1_000_000.0,
+                "encodeP95Ms" to percentile(sortedEncode, 95) / 1_000_000.0,
+            )
+        }
+
+        /**
+         * 最近样本窗口内的每秒下发次数
+         */
+        private fun rate(): Double {
+            if (size < 2) {
+                return 0.0
+            }
+            val window = times.copyOf(size)
+            val span = window.max() - window.min()
+            return if (span > 0) (size - 1) * 1_000_000_000.0 / span else 0.0
+        }
+
+        private fun percentile(sorted: List<Long>, p: Int): Long {
+            if (sorted.isEmpty()) {
+                return 0L
+            }
+            return sorted[minOf(sorted.size - 1, sorted.size * p / 100)]
+        }
+    }
+}
@@ -0,0 +1,114 @@
+package uts.sdk.modules.atomicx.observer
+
+import android.os.SystemClock
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.Job
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.launch
+
+/**
+ * 高频 store 事件的限频下发：按 store + key 配置最大频率，窗口内只保留最新值并在窗口结束时补发，未配置的 key 立即下发
+ */
+object BridgeRateLimiter {
+    private class KeyState {
+        var lastSentTime = 0L
+        var pendingData: String? = null
+        var isFlushScheduled = false
+    }
+
+    private val lock = Any()
+    private val intervals = hashMapOf(
+        "Device.currentMicVolume" to 100L,
+        "Device.captureVolume" to 100L,
+        "Device.networkInfo" to 1000L,
+        "LiveSeat.speakingUsers" to 100L,
+    )
+    private var coalescedCount = 0L
+
+    /**
+     * 设置 store 事件的最大下发频率（次/秒），maxRate <= 0 时取消限频
+     */
+    fun setMaxRate(store: String, key: String, maxRate: Double) {
+        synchronized(lock) {
+            val id = "$store.$key"
+            if (maxRate > 0) {
+                intervals[id] = (1000 / maxRate).toLong()
+            } else {
+                intervals.remove(id)
+            }
+        }
+    }
+
+    /**
+     * 包装 store 的回调：配置了频率的 key 按最新值合并下发，补发在该 store 的 dispatcher 上执行，保持与其他事件的顺序。
+     * 补发协程是订阅 job 的子任务，取消订阅后等待中的补发随之取消，不会在取消后再下发
+     */
+    fun rateLimitedCallback(store: String, job: Job, callback: (String, String) -> Unit): (String, String) -> Unit {
+        // 每个包装回调（即每个直播间的订阅）独立的限频状态，避免不同房间的最新值互相覆盖
+        val states = HashMap<String, KeyState>()
+        val scope = CoroutineScope(BridgeEncoder.dispatcher(store) + job)
+        return { name, data -> deliver(scope, store, name, data, states, callback) }
+    }
+
+    /**
+     * 被合并掉（未下发）的事件数
+     */
+    fun coalescedEventCount(): Long {
+        synchronized(lock) {
+            return coalescedCount
+        }
+    }
+
+    private fun deliver(
+        scope: CoroutineScope,
+        store: String,
+        name: String,
+        data: String,
+        states: HashMap<String, KeyState>,
+        callback: (String, String) -> Unit,
+    ) {
+        val delayMs = synchronized(lock) { scheduleDelay(states, store, name, data) }
+        when {
+            delayMs == null -> callback(name, data)
+            delayMs >= 0 -> scope.launch {
+                delay(delayMs)
+                flush(states, name, callback)
+            }
+        }
+    }
+
+    /**
+     * 返回 null 表示立即下发，>= 0 表示需要在该延迟后补发，-1 表示已有补发在等待，只更新最新值
+     */
+    private fun scheduleDelay(states: HashMap<String, KeyState>, store: String, name: String, data: String): Long? {
+        val interval = intervals["$store.$name"] ?: return null
+        val state = states.getOrPut(name) { KeyState() }
+        val now = SystemClock.uptimeMillis()
+        if (!state.isFlushScheduled && now - state.lastSentTime >= interval) {
+            state.lastSentTime = now
+            return null
+        }
+        if (state.pendingData != null) {
+            coalescedCount++
+            BridgeMetrics.recordCoalesced(store, name)
+        }
+        state.pendingData = data
+        if (state.isFlushScheduled) {
+            return -1
+        }
+        state.isFlushScheduled = true
+        return maxOf(0L, state.lastSentTime + interval - now)
+    }
+
+    private fun flush(states: HashMap<String, KeyState>, name: String, callback: (String, String) -> Unit) {
+        val data = synchronized(lock) {
+            val state = states[name] ?: return
+            state.isFlushScheduled = false
+            val pending = state.pendingData ?: return
+            state.pendingData = null
+            state.lastSentTime = SystemClock.uptimeMillis()
+            pending
+        }
+        callback(name, data)
+    }
+}
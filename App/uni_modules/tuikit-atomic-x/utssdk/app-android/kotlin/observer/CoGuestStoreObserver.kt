@@ -1,72 +1,49 @@
 package uts.sdk.modules.atomicx.observer
 
-import com.google.gson.Gson
 import io.trtc.tuikit.atomicxcore.api.CoGuestStore
-import io.trtc.tuikit.atomicxcore.api.DeviceStatus
-import io.trtc.tuikit.atomicxcore.api.Role
-import io.trtc.tuikit.atomicxcore.api.SeatUserInfo
 import kotlinx.coroutines.CoroutineScope
-import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.launch
 
 object CoGuestStoreObserver {
-    private val gson = Gson()
-    private var bindDataJob: Job? = null
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private val roomJobs = HashMap<String, Job>()
+
+    /**
+     * 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+     */
+    fun unsubscribe(liveID: String) {
+        roomJobs.remove(liveID)?.cancel()
+    }
 
     fun coGuestStoreChanged(liveID: String, callback: (String, String) -> Unit) {
-        bindDataJob?.cancel()
-        bindDataJob = CoroutineScope(Dispatchers.Main).launch {
+        roomJobs.remove(liveID)?.cancel()
+        val callback = BridgeDeduplicator.distinctCallback(
+            "CoGuest",
+            liveID,
+            BridgeEncoder.mainThreadCallback("CoGuest", callback),
+        )
+        roomJobs[liveID] = CoroutineScope(BridgeEncoder.dispatcher("CoGuest")).launch {
             launch {
                 CoGuestStore.create(liveID).coGuestState.connected.collect { connected ->
-                    val list = connected.map { convertSeatInfoToMap(it) }
-                    callback("connected", gson.toJson(list)) // SeatUserInfo
+                    callback("connected", ModelEncoder.encodeList(connected, false) { writeSeatUserInfo(it) })
                 }
             }
             launch {
                 CoGuestStore.create(liveID).coGuestState.invitees.collect { invitees ->
-                    callback("invitees", gson.toJson(invitees)) // LiveUserInfo
+                    callback("invitees", ModelEncoder.encodeList(invitees, false) { writeLiveUserInfo(it) })
                 }
             }
             launch {
                 CoGuestStore.create(liveID).coGuestState.applicants.collect { applicants ->
-                    callback("applicants", gson.toJson(applicants)) // LiveUserInfo
+                    callback("applicants", ModelEncoder.encodeList(applicants, false) { writeLiveUserInfo(it) })
                 }
             }
             launch {
                 CoGuestStore.create(liveID).coGuestState.candidates.collect { candidates ->
-                    callback("candidates", gson.toJson(candidates)) // LiveUserInfo
+                    callback("candidates", ModelEncoder.encodeList(candidates, false) { writeLiveUserInfo(it) })
                 }
             }
         }
     }
-
-    private fun convertSeatInfoToMap(info: SeatUserInfo): Map<String, Any> {
-        val map = mutableMapOf<String, Any>()
-        map["userID"] = info.userID
-        map["userName"] = info.userName
-        map["avatarURL"] = info.avatarURL
-        map["role"] = info.role
-        map["liveID"] = info.liveID
-        map["microphoneStatus"] = convertDeviceStatus(info.microphoneStatus)
-        map["allowOpenMicrophone"] = info.allowOpenMicrophone
-        map["cameraStatus"] = convertDeviceStatus(info.cameraStatus)
-        map["allowOpenCamera"] = info.allowOpenCamera
-        return map
-    }
-
-    private fun convertDeviceStatus(status: DeviceStatus?): String {
-        if (status == DeviceStatus.ON) {
-            return "ON"
-        }
-        return "OFF"
-    }
-
-    private fun convertUserRole(role: Role?): String {
-        return when (role) {
-            Role.OWNER -> "OWNER"
-            Role.ADMIN -> "ADMIN"
-            else -> "GENERAL_USER"
-        }
-    }
 }
@@ -3,41 +3,53 @@ package uts.sdk.modules.atomicx.observer
 import com.google.gson.Gson
 import io.trtc.tuikit.atomicxcore.api.CoHostStore
 import kotlinx.coroutines.CoroutineScope
-import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.launch
 
 object CoHostStoreObserver {
     private val gson = Gson()
-    private var bindDataJob: Job? = null
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private val roomJobs = HashMap<String, Job>()
+
+    /**
+     * 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+     */
+    fun unsubscribe(liveID: String) {
+        roomJobs.remove(liveID)?.cancel()
+    }
 
     fun coHostStoreChanged(liveID: String, callback: (String, String) -> Unit) {
-        bindDataJob?.cancel()
-        bindDataJob = CoroutineScope(Dispatchers.Main).launch {
+        roomJobs.remove(liveID)?.cancel()
+        val callback = BridgeDeduplicator.distinctCallback(
+            "CoHost",
+            liveID,
+            BridgeEncoder.mainThreadCallback("CoHost", callback),
+        )
+        roomJobs[liveID] = CoroutineScope(BridgeEncoder.dispatcher("CoHost")).launch {
             launch {
                 CoHostStore.create(liveID).coHostState.coHostStatus.collect { coHostStatus ->
-                    callback("coHostStatus", gson.toJson(coHostStatus))
+                    callback("coHostStatus", gson.toBridgeJson(coHostStatus))
                 }
             }
             launch {
                 CoHostStore.create(liveID).coHostState.connected.collect { connected ->
-                    callback("connected", gson.toJson(connected))
+                    callback("connected", gson.toBridgeJson(connected))
                 }
             }
             // TODO: 底层未实现，暂时隐藏
             // launch {
             //     CoHostStore.create(liveID).coHostState.candidates.collect { candidates ->
-            //         callback("candidates", gson.toJson(candidates))
+            //         callback("candidates", gson.toBridgeJson(candidates))
             //     }
             // }
             launch {
                 CoHostStore.create(liveID).coHostState.invitees.collect { invitees ->
-                    callback("invitees", gson.toJson(invitees))
+                    callback("invitees", gson.toBridgeJson(invitees))
                 }
             }
             launch {
                 CoHostStore.create(liveID).coHostState.applicant.collect { applicant ->
-                    callback("applicant", gson.toJson(applicant))
+                    callback("applicant", gson.toBridgeJson(applicant))
                 }
             }
         }
@@ -3,7 +3,6 @@ package uts.sdk.modules.atomicx.observer
 import com.google.gson.Gson
 import io.trtc.tuikit.atomicxcore.api.DeviceStore
 import kotlinx.coroutines.CoroutineScope
-import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.launch
 
@@ -11,75 +10,94 @@ object DeviceStoreObserver {
     private val gson = Gson()
     private var bindDataJob: Job? = null
 
+    /**
+     * 取消 store 状态订阅，由 JS 侧订阅引用计数归零时调用
+     */
+    fun unsubscribe() {
+        bindDataJob?.cancel()
+        bindDataJob = null
+    }
+
     fun deviceStoreChanged(callback: (String, String) -> Unit) {
         bindDataJob?.cancel()
-        bindDataJob = CoroutineScope(Dispatchers.Main).launch {
+        val job = Job()
+        bindDataJob = job
+        val callback = BridgeDeduplicator.distinctCallback(
+            "Device",
+            BridgeRateLimiter.rateLimitedCallback("Device", job, BridgeEncoder.mainThreadCallback("Device", callback)),
+        )
+        CoroutineScope(BridgeEncoder.dispatcher("Device") + job).launch {
             launch {
                 DeviceStore.shared().deviceState.microphoneStatus.collect { status ->
-                    callback("microphoneStatus", gson.toJson(status.value))
+                    callback("microphoneStatus", gson.toBridgeJson(status.value))
                 }
             }
             launch {
                 DeviceStore.shared().deviceState.microphoneLastError.collect { deviceError ->
-                    callback("microphoneLastError", gson.toJson(deviceError.value))
+                    callback("microphoneLastError", gson.toBridgeJson(deviceError.value))
                 }
             }
             launch {
                 DeviceStore.shared().deviceState.captureVolume.collect { volume ->
-                    callback("captureVolume", gson.toJson(volume))
+                    callback("captureVolume", gson.toBridgeJson(volume))
                 }
             }
             launch {
                 DeviceStore.shared().deviceState.currentMicVolume.collect { volume ->
-                    callback("currentMicVolume", gson.toJson(volume))
+                    callback("currentMicVolume", gson.toBridgeJson(volume))
                 }
             }
             launch {
                 DeviceStore.shared().deviceState.outputVolume.collect { volume ->
-                    callback("outputVolume", gson.toJson(volume))
+                    callback("outputVolume", gson.toBridgeJson(volume))
                 }
             }
 
             launch {
                 DeviceStore.shared().deviceState.cameraStatus.collect { cameraStatus ->
-                    callback("cameraStatus", gson.toJson(cameraStatus.value))
+                    callback("cameraStatus", gson.toBridgeJson(cameraStatus.value))
                 }
             }
             launch {
                 DeviceStore.shared().deviceState.cameraLastError.collect { deviceError ->
-                    callback("cameraLastError", gson.toJson(deviceError.value))
+                    callback("cameraLastError", gson.toBridgeJson(deviceError.value))
                 }
             }
             launch {
                 DeviceStore.shared().deviceState.isFrontCamera.collect { isFrontCamera ->
-                    callback("isFrontCamera", gson.toJson(isFrontCamera))
+                    callback("isFrontCamera", gson.toBridgeJson(isFrontCamera))
                 }
             }
             launch {
                 DeviceStore.shared().deviceState.localMirrorType.collect { localMirrorType ->
-                    callback("localMirrorType", gson.toJson(localMirrorType))
+                    callback("localMirrorType", gson.toBridgeJson(localMirrorType))
                 }
             }
             launch {
                 DeviceStore.shared().deviceState.localVideoQuality.collect { quality ->
-                    callback("localVideoQuality", gson.toJson(quality))
+                    callback("localVideoQuality", gson.toBridgeJson(quality))
                 }
             }
 
             launch {
                 DeviceStore.shared().deviceState.currentAudioRoute.collect { audioRoute ->
-                    callback("currentAudioRoute", gson.toJson(audioRoute.value))
+                    callback("currentAudioRoute", gson.toBridgeJson(audioRoute.value))
                 }
             }
             launch {
                 DeviceStore.shared().deviceState.screenStatus.collect { screenStatus ->
-                    callback("screenStatus", gson.toJson(screenStatus.value))
+                    callback("screenStatus", gson.toBridgeJson(screenStatus.value))
                 }
             }
 
             launch {
                 DeviceStore.shared().deviceState.networkInfo.collect { networkInfo ->
-                    callback("networkInfo", gson.toJson(networkInfo))
+                    val json = if (WireSchema.isEnabled) {
+                        WireSchema.encodeObject(gson, networkInfo, WireSchema.networkInfo)
+                    } else {
+                        gson.toBridgeJson(networkInfo)
+                    }
+                    callback("networkInfo", json)
                 }
             }
         }
@@ -1,22 +1,33 @@
 package uts.sdk.modules.atomicx.observer
 
-import com.google.gson.Gson
 import io.trtc.tuikit.atomicxcore.api.GiftStore
 import kotlinx.coroutines.CoroutineScope
-import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.launch
 
 object GiftStoreObserver {
-    private val gson = Gson()
-    private var bindDataJob: Job? = null
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private val roomJobs = HashMap<String, Job>()
+
+    /**
+     * 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+     */
+    fun unsubscribe(liveID: String) {
+        roomJobs.remove(liveID)?.cancel()
+    }
 
     fun giftStoreChanged(liveID: String, callback: (String, String) -> Unit) {
-        bindDataJob?.cancel()
-        bindDataJob = CoroutineScope(Dispatchers.Main).launch {
+        roomJobs.remove(liveID)?.cancel()
+        val callback = BridgeDeduplicator.distinctCallback(
+            "Gift",
+            liveID,
+            BridgeEncoder.mainThreadCallback("Gift", callback),
+        )
+        roomJobs[liveID] = CoroutineScope(BridgeEncoder.dispatcher("Gift")).launch {
             launch {
                 GiftStore.create(liveID).giftState.usableGifts.collect { usableGifts ->
-                    callback("usableGifts", gson.toJson(usableGifts))
+                    val json = ModelEncoder.encodeList(usableGifts, false) { writeGiftCategory(it) }
+                    callback("usableGifts", json)
                 }
             }
         }
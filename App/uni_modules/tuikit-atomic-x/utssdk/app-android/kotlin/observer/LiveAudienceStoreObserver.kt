@@ -1,31 +1,152 @@
 package uts.sdk.modules.atomicx.observer
 
 import com.google.gson.Gson
+import com.tencent.cloud.tuikit.engine.common.TUICommonDefine
+import com.tencent.cloud.tuikit.engine.room.TUIRoomDefine
+import com.tencent.cloud.tuikit.engine.room.TUIRoomEngine
 import io.trtc.tuikit.atomicxcore.api.LiveAudienceStore
+import io.trtc.tuikit.atomicxcore.api.LiveUserInfo
 import kotlinx.coroutines.CoroutineScope
-import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.launch
 
 object LiveAudienceStoreObserver {
     private val gson = Gson()
-    private var bindDataJob: Job? = null
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private val roomJobs = HashMap<String, Job>()
+
+    // JS 侧观众名单窗口大小，全量及单次新增下发的观众数量不超过该值；在命令线程写入、在 LiveAudience 编码线程读取
+    @Volatile
+    var audienceWindowSize = 100
+    // 单个直播间已下发到 JS 名单窗口的观众（按下发顺序，值为下发时的资料），用于计算 joined/left/updated 增量；
+    // 只在 LiveAudience 编码线程上读写
+    private class AudienceSnapshot {
+        var sent: LinkedHashMap<String, Pair<String, String>>? = null
+    }
+
+    private fun profileOf(user: LiveUserInfo) = Pair(user.userName ?: "", user.avatarURL ?: "")
+
+    /**
+     * 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+     */
+    fun unsubscribe(liveID: String) {
+        roomJobs.remove(liveID)?.cancel()
+    }
 
     fun liveAudienceStoreChanged(liveID: String, callback: (String, String) -> Unit) {
-        bindDataJob?.cancel()
-        bindDataJob = CoroutineScope(Dispatchers.Main).launch {
+        roomJobs.remove(liveID)?.cancel()
+        val callback = BridgeDeduplicator.distinctCallback(
+            "LiveAudience",
+            liveID,
+            BridgeEncoder.mainThreadCallback("LiveAudience", callback),
+        )
+        roomJobs[liveID] = CoroutineScope(BridgeEncoder.dispatcher("LiveAudience")).launch {
+            val snapshot = AudienceSnapshot()
             launch {
                 LiveAudienceStore.create(liveID).liveAudienceState.audienceList.collect { audienceList ->
-                    callback("audienceList", gson.toJson(audienceList))
+                    syncAudienceList(audienceList, snapshot, callback)
                 }
             }
 
             launch {
                 LiveAudienceStore.create(liveID).liveAudienceState.audienceCount.collect { audienceCount ->
-                    callback("audienceCount", gson.toJson(audienceCount))
+                    callback("audienceCount", gson.toBridgeJson(audienceCount))
                 }
             }
 
         }
     }
-} 
\ No newline at end of file
+
+    /**
+     * 首次同步下发窗口内的全量名单，之后只下发相对已下发窗口的增量：离开的 userID（left）、资料变化的观众（updated），
+     * 以及补满窗口的观众（joined）。窗口已满时新进入的观众暂不下发，窗口内有人离开后按名单顺序补入
+     */
+    private fun syncAudienceList(
+        audienceList: List<LiveUserInfo>,
+        snapshot: AudienceSnapshot,
+        callback: (String, String) -> Unit,
+    ) {
+        val sent = snapshot.sent
+        if (sent == null) {
+            val window = audienceList.take(audienceWindowSize)
+            snapshot.sent = window.associateTo(LinkedHashMap()) { it.userID to profileOf(it) }
+            val json = if (UserInternTable.isEnabled) {
+                val handles = UserInternTable.intern(window, callback)
+                ModelEncoder.encodeList(handles) { value(it) }
+            } else {
+                ModelEncoder.encodeList(window) { writeLiveUserInfo(it) }
+            }
+            callback("audienceList", json)
+            return
+        }
+        val current = audienceList.associateBy { it.userID }
+        val left = sent.keys.filter { !current.containsKey(it) }
+        left.forEach { sent.remove(it) }
+        // 窗口缩小时 JS 侧从尾部裁剪，这里同步移出
+        while (sent.size > audienceWindowSize) {
+            sent.remove(sent.keys.last())
+        }
+        val updated = sent.keys.mapNotNull { userID ->
+            current[userID]?.takeIf { profileOf(it) != sent[userID] }
+        }
+        updated.forEach { sent[it.userID] = profileOf(it) }
+        val joined = ArrayList<LiveUserInfo>()
+        for (user in audienceList) {
+            if (sent.size >= audienceWindowSize) break
+            if (!sent.containsKey(user.userID)) {
+                sent[user.userID] = profileOf(user)
+                joined.add(user)
+            }
+        }
+        if (joined.isEmpty() && left.isEmpty() && updated.isEmpty()) {
+            return
+        }
+        val handles = if (UserInternTable.isEnabled) UserInternTable.intern(joined + updated, callback) else null
+        val writeUsers: BridgeJsonWriter.(List<LiveUserInfo>, Int) -> Unit = { users, offset ->
+            beginArray()
+            if (handles != null) {
+                users.indices.forEach { value(handles[offset + it]) }
+            } else {
+                users.forEach { writeLiveUserInfo(it) }
+            }
+            endArray()
+        }
+        val json = ModelEncoder.encode {
+            if (WireSchema.isEnabled) {
+                beginArray()
+                value(WireSchema.TAG)
+                writeUsers(joined, 0)
+                anyValue(left)
+                writeUsers(updated, joined.size)
+                endArray()
+            } else {
+                beginMap()
+                name("joined")
+                writeUsers(joined, 0)
+                name("left").anyValue(left)
+                name("updated")
+                writeUsers(updated, joined.size)
+                endMap()
+            }
+        }
+        callback("audienceListDelta", json)
+    }
+
+    /**
+     * 通过 TUIRoomEngine 分页拉取观众名单，用于加载窗口之外的观众
+     */
+    fun fetchAudienceListPage(nextSequence: Long, onSuccess: (String) -> Unit, onError: (Int, String) -> Unit) {
+        TUIRoomEngine.sharedInstance().getUserList(nextSequence, object : TUIRoomDefine.GetUserListCallback {
+            override fun onSuccess(result: TUIRoomDefine.UserListResult) {
+                val list = result.userInfoList.map {
+                    mapOf("userID" to it.userId, "userName" to it.userName, "avatarURL" to it.avatarUrl)
+                }
+                onSuccess(gson.toBridgeJson(mapOf("audienceList" to list, "nextSequence" to result.nextSequence)))
+            }
+
+            override fun onError(error: TUICommonDefine.Error, message: String) {
+                onError(error.value, message)
+            }
+        })
+    }
+}
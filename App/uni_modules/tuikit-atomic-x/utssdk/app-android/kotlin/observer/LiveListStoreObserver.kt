@@ -1,9 +1,9 @@
 package uts.sdk.modules.atomicx.observer
 
 import com.google.gson.Gson
+import io.trtc.tuikit.atomicxcore.api.LiveInfo
 import io.trtc.tuikit.atomicxcore.api.LiveListStore
 import kotlinx.coroutines.CoroutineScope
-import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.launch
 
@@ -11,25 +11,69 @@ object LiveListStoreObserver {
     private val gson = Gson()
     private var bindDataJob: Job? = null
 
+    // 以下状态只在 LiveList dispatcher 上访问
+    private var liveInfoFields: Set<String>? = null
+    private var includeFullList = true
+    private var lastLiveList: List<LiveInfo> = emptyList()
+    private var liveListCallback: ((String, String) -> Unit)? = null
+
+    /**
+     * 取消 store 状态订阅，由 JS 侧订阅引用计数归零时调用
+     */
+    fun unsubscribe() {
+        bindDataJob?.cancel()
+        bindDataJob = null
+        CoroutineScope(BridgeEncoder.dispatcher("LiveList")).launch {
+            liveListCallback = null
+            lastLiveList = emptyList()
+        }
+    }
+
     fun liveStoreChanged(callback: (String, String) -> Unit) {
         bindDataJob?.cancel()
-        bindDataJob = CoroutineScope(Dispatchers.Main).launch {
+        val callback = BridgeDeduplicator.distinctCallback(
+            "LiveList",
+            BridgeEncoder.mainThreadCallback("LiveList", callback),
+        )
+        bindDataJob = CoroutineScope(BridgeEncoder.dispatcher("LiveList")).launch {
+            liveListCallback = callback
             launch {
                 LiveListStore.shared().liveState.liveList.collect { liveList ->
-                    callback("liveList", gson.toJson(liveList))
+                    lastLiveList = liveList
+                    emitLiveList(callback)
                 }
             }
             launch {
                 LiveListStore.shared().liveState.liveListCursor.collect { cursor ->
-                    callback("liveListCursor", gson.toJson(cursor))
+                    callback("liveListCursor", gson.toBridgeJson(cursor))
                 }
             }
 
             launch {
                 LiveListStore.shared().liveState.currentLive.collect { liveInfo ->
-                    callback("currentLive", gson.toJson(liveInfo))
+                    callback("currentLive", ModelEncoder.encode(false) { writeLiveInfo(liveInfo) })
                 }
             }
         }
     }
-} 
+
+    /**
+     * 设置 liveList 的字段投影：fields 非 null 时按投影下发 liveListProjected，includeFullList 为 false 时不再下发完整的 liveList。
+     * 变更后立即按新设置重新下发当前列表
+     */
+    fun setLiveInfoProjection(fields: List<String>?, includeFullList: Boolean) {
+        CoroutineScope(BridgeEncoder.dispatcher("LiveList")).launch {
+            liveInfoFields = fields?.toSet()
+            this@LiveListStoreObserver.includeFullList = includeFullList || fields == null
+            liveListCallback?.let { emitLiveList(it) }
+        }
+    }
+
+    private fun emitLiveList(callback: (String, String) -> Unit) {
+        if (includeFullList) {
+            callback("liveList", ModelEncoder.encodeList(lastLiveList) { writeLiveInfo(it, null) })
+        }
+        val fields = liveInfoFields ?: return
+        callback("liveListProjected", ModelEncoder.encodeList(lastLiveList) { writeLiveInfo(it, fields) })
+    }
+}
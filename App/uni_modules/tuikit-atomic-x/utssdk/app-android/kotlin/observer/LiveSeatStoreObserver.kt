@@ -1,9 +1,12 @@
 package uts.sdk.modules.atomicx.observer
 
 import com.google.gson.Gson
+import com.google.gson.JsonArray
+import com.google.gson.JsonNull
+import com.google.gson.JsonObject
+import com.google.gson.JsonParser
 import io.trtc.tuikit.atomicxcore.api.LiveSeatStore
 import kotlinx.coroutines.CoroutineScope
-import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.launch
 import uts.sdk.modules.atomicx.kotlin.Logger
@@ -11,29 +14,113 @@ import io.dcloud.uts.console
 
 object LiveSeatStoreObserver {
     private val gson = Gson()
-    private var bindDataJob: Job? = null
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private val roomJobs = HashMap<String, Job>()
+
+    /**
+     * 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+     */
+    fun unsubscribe(liveID: String) {
+        roomJobs.remove(liveID)?.cancel()
+    }
 
     fun liveSeatStoreChanged(liveID: String, callback: (String, String) -> Unit) {
-        bindDataJob?.cancel()
-        bindDataJob = CoroutineScope(Dispatchers.Main).launch {
+        roomJobs.remove(liveID)?.cancel()
+        val job = Job()
+        roomJobs[liveID] = job
+        val callback = BridgeDeduplicator.distinctCallback(
+            "LiveSeat", liveID,
+            BridgeRateLimiter.rateLimitedCallback("LiveSeat", job, BridgeEncoder.mainThreadCallback("LiveSeat", callback)),
+        )
+        CoroutineScope(BridgeEncoder.dispatcher("LiveSeat") + job).launch {
+            // 该直播间上一次下发给 JS 侧的座位快照（每个座位的 JSON），用于计算按 index 的增量补丁
+            var lastSeatList: List<String> = emptyList()
             launch {
                 LiveSeatStore.create(liveID).liveSeatState.seatList.collect { seatList ->
-                    val list = gson.toJson(seatList)
-                    console.info("UTS-Live: liveSeatStoreChanged, seatList: ", list)
-                    Logger.i("UTS-Live: " + "liveSeatStoreChanged, seatList: "+ list);
-                    callback("seatList", gson.toJson(seatList))
+                    val seats = seatList.map { seat -> ModelEncoder.encode(false) { writeSeatInfo(seat) } }
+                    val patches = diffSeatList(lastSeatList, seats)
+                    lastSeatList = seats
+                    if (patches == null) {
+                        val list = if (WireSchema.isEnabled) {
+                            ModelEncoder.encodeList(seatList, true) { writeSeatInfo(it) }
+                        } else {
+                            seats.joinToString(",", "[", "]")
+                        }
+                        console.info("UTS-Live: liveSeatStoreChanged, seatList: ", list)
+                        Logger.i("UTS-Live: " + "liveSeatStoreChanged, seatList: " + list)
+                        callback("seatList", list)
+                    } else if (patches.size() > 0) {
+                        val patch = gson.toBridgeJson(patches)
+                        Logger.i("UTS-Live: " + "liveSeatStoreChanged, seatListPatch: " + patch)
+                        callback("seatListPatch", patch)
+                    }
                 }
             }
             launch {
                 LiveSeatStore.create(liveID).liveSeatState.canvas.collect { canvas ->
-                    callback("canvas", gson.toJson(canvas))
+                    callback("canvas", gson.toBridgeJson(canvas))
                 }
             }
             launch {
                 LiveSeatStore.create(liveID).liveSeatState.speakingUsers.collect { speakingUsers ->
-                    callback("speakingUsers", gson.toJson(speakingUsers))
+                    val json = if (WireSchema.isEnabled) {
+                        WireSchema.encodeMap(gson, speakingUsers)
+                    } else {
+                        gson.toBridgeJson(speakingUsers)
+                    }
+                    callback("speakingUsers", json)
+                }
+            }
+        }
+    }
+
+    /**
+     * 按 index 比较新旧座位列表，返回仅包含变化字段的补丁；座位数量或顺序变化时返回 null，需要下发全量。
+     * 座位 JSON 未变化时直接跳过，只对变化的座位解析后逐字段比较
+     */
+    private fun diffSeatList(old: List<String>, new: List<String>): JsonArray? {
+        if (old.isEmpty() || old.size != new.size) {
+            return null
+        }
+        val patches = JsonArray()
+        for (i in new.indices) {
+            if (old[i] == new[i]) {
+                continue
+            }
+            val oldSeat = JsonParser.parseString(old[i]).asJsonObject
+            val newSeat = JsonParser.parseString(new[i]).asJsonObject
+            val index = newSeat.get("index")
+            if (index == null || index != oldSeat.get("index")) {
+                return null
+            }
+            val patch = diffJsonObject(oldSeat, newSeat)
+            if (patch.size() > 0) {
+                patch.add("index", index)
+                patches.add(patch)
+            }
+        }
+        return patches
+    }
+
+    private fun diffJsonObject(old: JsonObject, new: JsonObject): JsonObject {
+        val changed = JsonObject()
+        for ((key, value) in new.entrySet()) {
+            val oldValue = old.get(key)
+            if (oldValue != null && oldValue.isJsonObject && value.isJsonObject) {
+                val nested = diffJsonObject(oldValue.asJsonObject, value.asJsonObject)
+                if (nested.size() > 0) {
+                    changed.add(key, nested)
                 }
+            } else if (oldValue != value) {
+                changed.add(key, value)
+            }
+        }
+        // Gson 不输出 null 字段，旧快照中存在而新快照中缺失的字段需要显式置空
+        for (key in old.keySet()) {
+            if (!new.has(key)) {
+                changed.add(key, JsonNull.INSTANCE)
             }
         }
+        return changed
     }
-} 
\ No newline at end of file
+}
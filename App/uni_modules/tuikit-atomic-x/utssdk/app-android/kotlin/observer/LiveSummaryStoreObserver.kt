@@ -9,11 +9,19 @@ import kotlinx.coroutines.launch
 
 object LiveSummaryStoreObserver {
     private val gson = Gson()
-    private var bindDataJob: Job? = null
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private val roomJobs = HashMap<String, Job>()
+
+    /**
+     * 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+     */
+    fun unsubscribe(liveID: String) {
+        roomJobs.remove(liveID)?.cancel()
+    }
 
     fun liveSummaryStoreChanged(liveID: String, callback: (String, String) -> Unit) {
-        bindDataJob?.cancel()
-        bindDataJob = CoroutineScope(Dispatchers.Main).launch {
+        roomJobs.remove(liveID)?.cancel()
+        roomJobs[liveID] = CoroutineScope(Dispatchers.Main).launch {
             launch {
                 // 底层隐藏
                 // LiveSummaryStore.create(liveID).liveSummaryState.summaryData.collect { data ->
@@ -5,7 +5,6 @@ import com.google.gson.GsonBuilder
 import io.trtc.tuikit.atomicxcore.api.LoginStatus
 import io.trtc.tuikit.atomicxcore.api.LoginStore
 import kotlinx.coroutines.CoroutineScope
-import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.launch
 
@@ -13,18 +12,27 @@ object LoginStoreObserver {
     private val gson = GsonBuilder().serializeNulls().create()
     private var bindDataJob: Job? = null
 
+    /**
+     * 取消 store 状态订阅，由 JS 侧订阅引用计数归零时调用
+     */
+    fun unsubscribe() {
+        bindDataJob?.cancel()
+        bindDataJob = null
+    }
+
     fun loginStoreChanged(callback: (String, String) -> Unit) {
         bindDataJob?.cancel()
-        bindDataJob = CoroutineScope(Dispatchers.Main).launch {
+        val callback = BridgeDeduplicator.distinctCallback("Login", BridgeEncoder.mainThreadCallback("Login", callback))
+        bindDataJob = CoroutineScope(BridgeEncoder.dispatcher("Login")).launch {
             launch {
                 LoginStore.shared.loginState.loginUserInfo.collect { userInfo ->
-                    callback("loginUserInfo", gson.toJson(userInfo))
+                    callback("loginUserInfo", gson.toBridgeJson(userInfo))
                 }
             }
             launch {
                 LoginStore.shared.loginState.loginStatus.collect { loginStatus ->
                     // UNLOGIN \ LOGINED
-                    callback("loginStatus", gson.toJson(loginStatus))
+                    callback("loginStatus", gson.toBridgeJson(loginStatus))
                 }
             }
         }
@@ -0,0 +1,360 @@
+package uts.sdk.modules.atomicx.observer
+
+import io.trtc.tuikit.atomicxcore.api.Barrage
+import io.trtc.tuikit.atomicxcore.api.BarrageType
+import io.trtc.tuikit.atomicxcore.api.DeviceStatus
+import io.trtc.tuikit.atomicxcore.api.Gift
+import io.trtc.tuikit.atomicxcore.api.GiftCategory
+import io.trtc.tuikit.atomicxcore.api.LiveInfo
+import io.trtc.tuikit.atomicxcore.api.LiveUserInfo
+import io.trtc.tuikit.atomicxcore.api.RegionInfo
+import io.trtc.tuikit.atomicxcore.api.Role
+import io.trtc.tuikit.atomicxcore.api.SeatInfo
+import io.trtc.tuikit.atomicxcore.api.SeatUserInfo
+import io.trtc.tuikit.atomicxcore.api.TakeSeatMode
+
+/**
+ * 直接写 StringBuilder 的 JSON 输出，compact 为 true 时模型对象按 schema 顺序输出为数组（与 WireSchema 一致），
+ * map 类字段（extensionInfo、metaData）始终输出为 JSON 对象
+ */
+class BridgeJsonWriter {
+    private val builder = StringBuilder(1024)
+    private var compact = false
+    private var needsComma = false
+    private var pendingName: String? = null
+
+    // 当前容器是否为紧凑输出的模型对象，按嵌套层级入栈
+    private val compactStack = BooleanArray(32)
+    private var depth = 0
+
+    fun reset(compact: Boolean): BridgeJsonWriter {
+        builder.setLength(0)
+        this.compact = compact
+        needsComma = false
+        pendingName = null
+        depth = 0
+        return this
+    }
+
+    fun beginModel(): BridgeJsonWriter = begin(if (compact) '[' else '{', compact)
+
+    fun endModel(): BridgeJsonWriter = end(if (compact) ']' else '}')
+
+    fun beginMap(): BridgeJsonWriter = begin('{', false)
+
+    fun endMap(): BridgeJsonWriter = end('}')
+
+    fun beginArray(): BridgeJsonWriter = begin('[', true)
+
+    fun endArray(): BridgeJsonWriter = end(']')
+
+    /**
+     * 字段名延迟到写值时输出，JSON 格式下值为 null 的字段整体省略（与 Gson 默认行为一致），紧凑格式下输出 null 占位
+     */
+    fun name(name: String): BridgeJsonWriter {
+        pendingName = name
+        return this
+    }
+
+    fun value(value: String?): BridgeJsonWriter {
+        if (value == null) return nullValue()
+        writePrefix()
+        writeString(value)
+        return this
+    }
+
+    fun value(value: Boolean): BridgeJsonWriter {
+        writePrefix()
+        builder.append(value)
+        return this
+    }
+
+    fun value(value: Long): BridgeJsonWriter {
+        writePrefix()
+        builder.append(value)
+        return this
+    }
+
+    fun value(value: Int): BridgeJsonWriter = value(value.toLong())
+
+    fun nullValue(): BridgeJsonWriter {
+        if (depth > 0 && !compactStack[depth - 1]) {
+            pendingName = null
+            return this
+        }
+        writePrefix()
+        builder.append("null")
+        return this
+    }
+
+    fun stringMap(map: Map<String, *>?): BridgeJsonWriter {
+        if (map == null) return nullValue()
+        beginMap()
+        for ((key, value) in map) {
+            name(key).anyValue(value)
+        }
+        return endMap()
+    }
+
+    fun anyValue(value: Any?): BridgeJsonWriter {
+        return when (value) {
+            null -> nullValue()
+            is String -> value(value)
+            is Boolean -> value(value)
+            is Int -> value(value)
+            is Long -> value(value)
+            is Number -> {
+                writePrefix()
+                builder.append(value)
+                this
+            }
+            is Map<*, *> -> {
+                beginMap()
+                for ((key, item) in value) {
+                    name(key.toString()).anyValue(item)
+                }
+                endMap()
+            }
+            is Iterable<*> -> {
+                beginArray()
+                value.forEach { anyValue(it) }
+                endArray()
+            }
+            else -> value(value.toString())
+        }
+    }
+
+    override fun toString(): String = builder.toString()
+
+    private fun begin(token: Char, compactContainer: Boolean): BridgeJsonWriter {
+        writePrefix()
+        builder.append(token)
+        compactStack[depth++] = compactContainer
+        needsComma = false
+        return this
+    }
+
+    private fun end(token: Char): BridgeJsonWriter {
+        depth--
+        builder.append(token)
+        needsComma = true
+        return this
+    }
+
+    private fun writePrefix() {
+        if (needsComma) {
+            builder.append(',')
+        }
+        val name = pendingName
+        if (name != null && depth > 0 && !compactStack[depth - 1]) {
+            writeString(name)
+            builder.append(':')
+        }
+        pendingName = null
+        needsComma = true
+    }
+
+    private fun writeString(value: String) {
+        builder.append('"')
+        for (c in value) {
+            when (c) {
+                '"' -> builder.append("\\\"")
+                '\\' -> builder.append("\\\\")
+                '\n' -> builder.append("\\n")
+                '\r' -> builder.append("\\r")
+                '\t' -> builder.append("\\t")
+                '\u2028' -> builder.append("\\u2028")
+                '\u2029' -> builder.append("\\u2029")
+                else -> if (c < ' ') {
+                    builder.append(String.format("\\u%04x", c.code))
+                } else {
+                    builder.append(c)
+                }
+            }
+        }
+        builder.append('"')
+    }
+}
+
+/**
+ * 桥接模型的静态编码，字段与取值和 iOS TypeConvert 的输出保持一致，字段顺序与 WireSchema 一致
+ */
+object ModelEncoder {
+    private val writer = ThreadLocal.withInitial { BridgeJsonWriter() }
+
+    /**
+     * 使用当前线程复用的 writer 编码，并计入 BridgeEncoder 的序列化耗时
+     */
+    fun encode(compact: Boolean = WireSchema.isEnabled, block: BridgeJsonWriter.() -> Unit): String {
+        val start = System.nanoTime()
+        try {
+            val writer = writer.get()!!.reset(compact)
+            writer.block()
+            return writer.toString()
+        } finally {
+            BridgeEncoder.recordEncode(System.nanoTime() - start, BridgeEncoder.isMainThread())
+        }
+    }
+
+    /**
+     * 编码模型列表：紧凑格式为 ["c1", header..., row...]，JSON 格式为对象数组
+     */
+    fun <T> encodeList(
+        items: List<T>,
+        compact: Boolean = WireSchema.isEnabled,
+        header: List<Long> = emptyList(),
+        write: BridgeJsonWriter.(T) -> Unit,
+    ): String {
+        return encode(compact) {
+            beginArray()
+            if (compact) {
+                value(WireSchema.TAG)
+                header.forEach { value(it) }
+            }
+            items.forEach { write(it) }
+            endArray()
+        }
+    }
+
+    fun convertUserRole(role: Role?): String {
+        return when (role) {
+            Role.ADMIN -> "ADMIN"
+            Role.GENERAL_USER -> "GENERAL_USER"
+            else -> "OWNER"
+        }
+    }
+
+    fun convertDeviceStatus(status: DeviceStatus?): String {
+        return if (status == DeviceStatus.ON) "ON" else "OFF"
+    }
+}
+
+fun BridgeJsonWriter.writeLiveUserInfo(info: LiveUserInfo?): BridgeJsonWriter {
+    if (info == null) return nullValue()
+    beginModel()
+    name("userID").value(info.userID ?: "")
+    name("userName").value(info.userName ?: "")
+    name("avatarURL").value(info.avatarURL ?: "")
+    return endModel()
+}
+
+fun BridgeJsonWriter.writeSeatUserInfo(info: SeatUserInfo?): BridgeJsonWriter {
+    if (info == null) return nullValue()
+    beginModel()
+    name("userID").value(info.userID)
+    name("userName").value(info.userName ?: "")
+    name("avatarURL").value(info.avatarURL ?: "")
+    name("role").value(ModelEncoder.convertUserRole(info.role))
+    name("liveID").value(info.liveID)
+    name("microphoneStatus").value(ModelEncoder.convertDeviceStatus(info.microphoneStatus))
+    name("allowOpenMicrophone").value(info.allowOpenMicrophone)
+    name("cameraStatus").value(ModelEncoder.convertDeviceStatus(info.cameraStatus))
+    name("allowOpenCamera").value(info.allowOpenCamera)
+    return endModel()
+}
+
+fun BridgeJsonWriter.writeRegion(region: RegionInfo?): BridgeJsonWriter {
+    if (region == null) return nullValue()
+    beginModel()
+    name("x").value(region.x)
+    name("y").value(region.y)
+    name("w").value(region.w)
+    name("h").value(region.h)
+    name("zorder").value(region.zorder)
+    return endModel()
+}
+
+fun BridgeJsonWriter.writeSeatInfo(seat: SeatInfo): BridgeJsonWriter {
+    beginModel()
+    name("index").value(seat.index)
+    name("isLocked").value(seat.isLocked)
+    name("userInfo").writeSeatUserInfo(seat.userInfo)
+    name("region").writeRegion(seat.region)
+    return endModel()
+}
+
+/**
+ * sender 不为空时只写入用户句柄（见 UserInternTable）
+ */
+fun BridgeJsonWriter.writeBarrage(barrage: Barrage, sender: Int? = null): BridgeJsonWriter {
+    beginModel()
+    name("liveID").value(barrage.liveID)
+    if (sender != null) {
+        name("sender").value(sender)
+    } else {
+        name("sender").writeLiveUserInfo(barrage.sender)
+    }
+    name("sequence").value(barrage.sequence)
+    name("timestampInSecond").value(barrage.timestampInSecond)
+    name("messageType").value(if (barrage.messageType == BarrageType.CUSTOM) "CUSTOM" else "TEXT")
+    name("textContent").value(barrage.textContent)
+    name("extensionInfo").stringMap(barrage.extensionInfo)
+    name("businessID").value(barrage.businessID)
+    name("data").value(barrage.data)
+    return endModel()
+}
+
+/**
+ * fields 不为空时只写入投影内的字段，其余字段在 JSON 格式下省略、紧凑格式下输出 null 占位
+ */
+fun BridgeJsonWriter.writeLiveInfo(liveInfo: LiveInfo?, fields: Set<String>? = null): BridgeJsonWriter {
+    if (liveInfo == null) return nullValue()
+    beginModel()
+    field("liveID", fields) { value(liveInfo.liveID) }
+    field("liveName", fields) { value(liveInfo.liveName) }
+    field("notice", fields) { value(liveInfo.notice) }
+    field("isMessageDisable", fields) { value(liveInfo.isMessageDisable) }
+    field("isPublicVisible", fields) { value(liveInfo.isPublicVisible) }
+    field("isSeatEnabled", fields) { value(liveInfo.isSeatEnabled) }
+    field("keepOwnerOnSeat", fields) { value(liveInfo.keepOwnerOnSeat) }
+    field("maxSeatCount", fields) { value(liveInfo.maxSeatCount) }
+    field("seatMode", fields) { value(if (liveInfo.seatMode == TakeSeatMode.APPLY) "APPLY" else "FREE") }
+    field("seatLayoutTemplateID", fields) { value(liveInfo.seatLayoutTemplateID) }
+    field("coverURL", fields) { value(liveInfo.coverURL) }
+    field("backgroundURL", fields) { value(liveInfo.backgroundURL) }
+    field("activityStatus", fields) { value(liveInfo.activityStatus) }
+    field("liveOwner", fields) { writeLiveUserInfo(liveInfo.liveOwner) }
+    field("createTime", fields) { value(liveInfo.createTime) }
+    field("categoryList", fields) { anyValue(liveInfo.categoryList) }
+    field("totalViewerCount", fields) { value(liveInfo.totalViewerCount) }
+    field("isGiftEnabled", fields) { value(liveInfo.isGiftEnabled) }
+    field("metaData", fields) { stringMap(liveInfo.metaData) }
+    return endModel()
+}
+
+private inline fun BridgeJsonWriter.field(key: String, fields: Set<String>?, write: BridgeJsonWriter.() -> Unit) {
+    name(key)
+    if (fields == null || fields.contains(key)) {
+        write()
+    } else {
+        nullValue()
+    }
+}
+
+/**
+ * 礼物不在紧凑格式范围内，始终输出为 JSON 对象
+ */
+fun BridgeJsonWriter.writeGift(gift: Gift): BridgeJsonWriter {
+    beginMap()
+    name("giftID").value(gift.giftID)
+    name("name").value(gift.name)
+    name("desc").value(gift.desc)
+    name("iconURL").value(gift.iconURL)
+    name("resourceURL").value(gift.resourceURL)
+    name("level").value(gift.level)
+    name("coins").value(gift.coins)
+    name("extensionInfo").stringMap(gift.extensionInfo)
+    return endMap()
+}
+
+fun BridgeJsonWriter.writeGiftCategory(category: GiftCategory): BridgeJsonWriter {
+    beginMap()
+    name("categoryID").value(category.categoryID)
+    name("name").value(category.name)
+    name("desc").value(category.desc)
+    name("extensionInfo").stringMap(category.extensionInfo)
+    name("giftList").beginArray()
+    category.giftList.forEach { writeGift(it) }
+    endArray()
+    return endMap()
+}
@@ -0,0 +1,89 @@
+package uts.sdk.modules.atomicx.observer
+
+import io.trtc.tuikit.atomicxcore.api.LiveUserInfo
+
+/**
+ * 用户资料驻留表：按 userID + 资料版本分配数字句柄，资料只在首次出现或变更时随 userProfiles 事件下发一次，
+ * 之后 messageList、audienceList 中的用户只携带句柄，JS 侧通过 utils/userTable.ts 还原
+ */
+object UserInternTable {
+    private class Entry(val handle: Int, val userName: String, val avatarURL: String)
+
+    /**
+     * 最小容量：一次 messageListReset/audienceList 的用户需同时驻留，否则同一批内分配的句柄会在 JS 还原前被淘汰
+     */
+    const val MIN_CAPACITY = 100
+
+    /**
+     * 是否启用句柄下发，由 JS 侧通过 setUserInterning 开启
+     */
+    @Volatile
+    var isEnabled = false
+        private set
+
+    private var capacity = 1000
+    private var nextHandle = 1
+    private val pendingEvicted = ArrayList<Int>()
+    private val entries = object : LinkedHashMap<String, Entry>(256, 0.75f, true) {
+        override fun removeEldestEntry(eldest: MutableMap.MutableEntry<String, Entry>): Boolean {
+            if (size > capacity) {
+                pendingEvicted.add(eldest.value.handle)
+                return true
+            }
+            return false
+        }
+    }
+
+    /**
+     * 开启或关闭句柄下发；每次调用都会清空驻留表，保证 JS 侧（可能已重新加载）重新收到完整资料。
+     * capacity 小于 MIN_CAPACITY 时按 MIN_CAPACITY 生效，由调用方输出告警
+     */
+    @Synchronized
+    fun setEnabled(enabled: Boolean, capacity: Int) {
+        isEnabled = enabled
+        this.capacity = maxOf(MIN_CAPACITY, capacity)
+        entries.clear()
+        pendingEvicted.clear()
+    }
+
+    /**
+     * 为一批用户分配句柄。新出现或资料变更的用户会先通过 callback 下发 userProfiles，
+     * 分配与下发在同一临界区内完成，保证其他 store 引用同一句柄时资料已先行投递到主线程
+     */
+    @Synchronized
+    fun intern(users: List<LiveUserInfo>, callback: (String, String) -> Unit): List<Int> {
+        val profiles = ArrayList<LiveUserInfo>()
+        val profileHandles = ArrayList<Int>()
+        val handles = users.map { user ->
+            val userName = user.userName ?: ""
+            val avatarURL = user.avatarURL ?: ""
+            val entry = entries[user.userID]
+            if (entry != null && entry.userName == userName && entry.avatarURL == avatarURL) {
+                entry.handle
+            } else {
+                entry?.let { pendingEvicted.add(it.handle) }
+                val handle = nextHandle++
+                entries[user.userID] = Entry(handle, userName, avatarURL)
+                profiles.add(user)
+                profileHandles.add(handle)
+                handle
+            }
+        }
+        if (profiles.isEmpty() && pendingEvicted.isEmpty()) {
+            return handles
+        }
+        val json = ModelEncoder.encode(false) {
+            beginMap()
+            name("users").beginMap()
+            for (i in profiles.indices) {
+                name(profileHandles[i].toString()).writeLiveUserInfo(profiles[i])
+            }
+            endMap()
+            name("evicted").anyValue(pendingEvicted)
+            endMap()
+        }
+        pendingEvicted.clear()
+        callback("userProfiles", json)
+        return handles
+    }
+}
@@ -0,0 +1,108 @@
+package uts.sdk.modules.atomicx.observer
+
+import com.google.gson.Gson
+import com.google.gson.JsonArray
+import com.google.gson.JsonElement
+import com.google.gson.JsonNull
+
+/**
+ * 紧凑传输格式的字段定义：按 schema 顺序输出字段值，不再重复携带 key 字符串
+ */
+class WireField(val key: String, val nested: List<WireField>? = null)
+
+/**
+ * 高频 store 事件的紧凑编码，字段顺序须与 utils/wireCodec.ts 中的 WireSchema 保持一致
+ */
+object WireSchema {
+    /**
+     * 紧凑格式标记，作为 JSON 数组的第一个元素，JS 侧据此选择解码方式
+     */
+    const val TAG = "c1"
+
+    /**
+     * 是否启用紧凑格式，由 JS 侧通过 setBridgeWireFormat 开启
+     */
+    @Volatile
+    var isEnabled = false
+
+    val liveUserInfo = listOf(WireField("userID"), WireField("userName"), WireField("avatarURL"))
+
+    val seatUserInfo = listOf(
+        WireField("userID"), WireField("userName"), WireField("avatarURL"), WireField("role"),
+        WireField("liveID"), WireField("microphoneStatus"), WireField("allowOpenMicrophone"),
+        WireField("cameraStatus"), WireField("allowOpenCamera"),
+    )
+
+    val region = listOf(WireField("x"), WireField("y"), WireField("w"), WireField("h"), WireField("zorder"))
+
+    val seatInfo = listOf(
+        WireField("index"), WireField("isLocked"), WireField("userInfo", seatUserInfo), WireField("region", region),
+    )
+
+    val barrage = listOf(
+        WireField("liveID"), WireField("sender", liveUserInfo), WireField("sequence"),
+        WireField("timestampInSecond"), WireField("messageType"), WireField("textContent"),
+        WireField("extensionInfo"), WireField("businessID"), WireField("data"),
+    )
+
+    val liveInfo = listOf(
+        WireField("liveID"), WireField("liveName"), WireField("notice"), WireField("isMessageDisable"),
+        WireField("isPublicVisible"), WireField("isSeatEnabled"), WireField("keepOwnerOnSeat"),
+        WireField("maxSeatCount"), WireField("seatMode"), WireField("seatLayoutTemplateID"),
+        WireField("coverURL"), WireField("backgroundURL"), WireField("activityStatus"),
+        WireField("liveOwner", liveUserInfo), WireField("createTime"), WireField("categoryList"),
+        WireField("totalViewerCount"), WireField("isGiftEnabled"), WireField("metaData"),
+    )
+
+    val networkInfo = listOf(
+        WireField("userID"), WireField("quality"), WireField("upLoss"), WireField("downLoss"), WireField("delay"),
+    )
+
+    fun pack(element: JsonElement, schema: List<WireField>): JsonArray {
+        val row = JsonArray(schema.size)
+        val obj = if (element.isJsonObject) element.asJsonObject else null
+        for (field in schema) {
+            val value = obj?.get(field.key) ?: JsonNull.INSTANCE
+            if (field.nested != null && value.isJsonObject) {
+                row.add(pack(value, field.nested))
+            } else {
+                row.add(value)
+            }
+        }
+        return row
+    }
+
+    /**
+     * 编码为 ["c1", header..., row...]
+     */
+    fun encode(gson: Gson, items: List<Any?>, schema: List<WireField>, header: List<JsonElement> = emptyList()): String {
+        val payload = JsonArray()
+        payload.add(TAG)
+        header.forEach { payload.add(it) }
+        items.forEach { payload.add(pack(gson.toJsonTree(it), schema)) }
+        return gson.toBridgeJson(payload)
+    }
+
+    /**
+     * 编码单个对象为 ["c1", row]
+     */
+    fun encodeObject(gson: Gson, item: Any?, schema: List<WireField>): String {
+        val payload = JsonArray()
+        payload.add(TAG)
+        payload.add(pack(gson.toJsonTree(item), schema))
+        return gson.toBridgeJson(payload)
+    }
+
+    /**
+     * 编码 userID -> 数值 的映射为 ["c1", key, value, key, value...]
+     */
+    fun encodeMap(gson: Gson, map: Map<String, Any?>): String {
+        val payload = JsonArray()
+        payload.add(TAG)
+        for ((key, value) in map) {
+            payload.add(key)
+            payload.add(gson.toJsonTree(value))
+        }
+        return gson.toBridgeJson(payload)
+    }
+}
@@ -0,0 +1,79 @@
+import Foundation
+
+/// store 事件去重：按 (store, liveID, key) 记录上一次下发数据的哈希，相同数据不再切回主线程下发
+public class BridgeDeduplicator {
+    public static let shared = BridgeDeduplicator()
+
+    /// 增量事件不是状态快照，相同内容也需要下发；value 为对应的全量 key（没有时为 nil）。
+    /// 增量下发后 JS 侧状态已不等于上一次全量，清掉全量 key 的哈希，使之后内容相同的全量仍会下发
+    private static let deltaKeys: [String: String?] = [
+        "messageListAppend": "messageListReset",
+        "audienceListDelta": "audienceList",
+        "seatListPatch": "seatList",
+        "userProfiles": nil,
+    ]
+
+    private let lock = NSLock()
+    private var suppressedCounts: [String: UInt64] = [:]
+    private var suppressedTotal: UInt64 = 0
+
+    /// 包装一次订阅的回调：去重状态随包装实例创建，重新订阅时当前值会重新下发且只下发一次
+    public func distinctCallback(
+        store: String,
+        liveID: String = "",
+        _ callback: @escaping (_ name: String, _ data: String) -> Void
+    ) -> (_ name: String, _ data: String) -> Void {
+        let stateLock = NSLock()
+        var lastHashes: [String: Int] = [:]
+        var emittedKeys = Set<String>()
+        return { [weak self] name, data in
+            if TraceRecorder.shared.isEnabled {
+                stateLock.lock()
+                let isFirst = emittedKeys.insert(name).inserted
+                stateLock.unlock()
+                if isFirst {
+                    // 每个订阅的每个 key 只记录首次下发，用于对齐 JS 侧的首次渲染
+                    TraceRecorder.shared.instant(name: "first \(store).\(name)", category: "store",
+                                                 threadID: TraceRecorder.storeThreadID, args: ["liveID": liveID])
+                }
+            }
+            if let baseKey = BridgeDeduplicator.deltaKeys[name] {
+                if let baseKey = baseKey {
+                    stateLock.lock()
+                    lastHashes.removeValue(forKey: baseKey)
+                    stateLock.unlock()
+                }
+                callback(name, data)
+                return
+            }
+            let hash = data.hashValue
+            stateLock.lock()
+            let isDuplicate = lastHashes[name] == hash
+            lastHashes[name] = hash
+            stateLock.unlock()
+            if isDuplicate {
+                self?.recordSuppressed(store: store, liveID: liveID, key: name)
+                BridgeMetrics.shared.recordSuppressed(store: store, key: name)
+                return
+            }
+            callback(name, data)
+        }
+    }
+
+    public func metrics() -> [String: Any] {
+        lock.lock()
+        defer { lock.unlock() }
+        return [
+            "suppressedTotal": suppressedTotal,
+            "suppressed": suppressedCounts,
+        ]
+    }
+
+    private func recordSuppressed(store: String, liveID: String, key: String) {
+        let id = liveID.isEmpty ? "\(store).\(key)" : "\(store).\(liveID).\(key)"
+        lock.lock()
+        defer { lock.unlock() }
+        suppressedCounts[id, default: 0] += 1
+        suppressedTotal += 1
+    }
+}
@@ -0,0 +1,75 @@
+import Foundation
+
+/// store 事件的编码阶段：每个 store 一个后台串行队列完成转换与序列化，只在回调 UTS 时切回主线程
+public class BridgeEncoder {
+    public static let shared = BridgeEncoder()
+
+    private let lock = NSLock()
+    private var queues: [String: DispatchQueue] = [:]
+
+    private var mainThreadEncodeNanos: UInt64 = 0
+    private var backgroundEncodeNanos: UInt64 = 0
+    private var mainThreadEncodeCount: UInt64 = 0
+    private var backgroundEncodeCount: UInt64 = 0
+
+    /// 获取 store 对应的串行编码队列，同一 store 的事件按到达顺序编码和下发
+    public func queue(for store: String) -> DispatchQueue {
+        lock.lock()
+        defer { lock.unlock() }
+        if let queue = queues[store] {
+            return queue
+        }
+        let queue = DispatchQueue(label: "com.tencent.atomicx.bridge.\(store)", qos: .userInitiated)
+        queues[store] = queue
+        return queue
+    }
+
+    /// 包装 UTS 回调：在编码队列上调用时切回主线程执行，主线程的 FIFO 保证同一 store 的事件顺序不变。
+    /// 位于去重与限频之后，在这里记录的才是实际下发的事件
+    public func mainThreadCallback(
+        store: String,
+        _ callback: @escaping (_ name: String, _ data: String) -> Void
+    ) -> (_ name: String, _ data: String) -> Void {
+        return { name, data in
+            BridgeMetrics.shared.recordEmission(store: store, key: name, data: data)
+            if Thread.isMainThread {
+                callback(name, data)
+            } else {
+                DispatchQueue.main.async {
+                    callback(name, data)
+                }
+            }
+        }
+    }
+
+    /// 记录一次序列化耗时，按是否在主线程分别累计
+    public func recordEncode(nanos: UInt64, onMainThread: Bool) {
+        BridgeMetrics.shared.recordEncode(nanos: nanos)
+        lock.lock()
+        defer { lock.unlock() }
+        if onMainThread {
+            mainThreadEncodeNanos += nanos
+            mainThreadEncodeCount += 1
+        } else {
+            backgroundEncodeNanos += nanos
+            backgroundEncodeCount += 1
+        }
+    }
+
+    public func metrics() -> [String: Any] {
+        lock.lock()
+        defer { lock.unlock() }
+        return [
+            "mainThreadEncodeMs": Double(mainThreadEncodeNanos) / 1_000_000,
+            "mainThreadEncodeCount": mainThreadEncodeCount,
+            "backgroundEncodeMs": Double(backgroundEncodeNanos) / 1_000_000,
+            "backgroundEncodeCount": backgroundEncodeCount,
+            "coalescedEventCount": BridgeRateLimiter.shared.coalescedEventCount(),
+            "dedup": BridgeDeduplicator.shared.metrics(),
+        ]
+    }
+
+    public func metricsJson() -> String {
+        return JsonUtil.toJson(metrics()) ?? "{}"
+    }
+}
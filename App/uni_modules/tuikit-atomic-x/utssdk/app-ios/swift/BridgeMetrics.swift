@@ -0,0 +1,165 @@
+import Foundation
+
+/// bridge 指标：按 (store, key) 统计下发频率、编码后字节数与 native 编码耗时，保留最近样本计算滚动分位数。
+/// count/频率/字节数只统计实际切回主线程下发的事件，被去重丢弃与被限频合并的事件分别计入 suppressed 与 coalesced。
+/// 默认关闭，关闭时每次下发只多一次布尔判断
+public class BridgeMetrics {
+    public static let shared = BridgeMetrics()
+
+    /// 每个 (store, key) 保留的最近样本数
+    fileprivate static let sampleCount = 128
+    private static let encodeNanosKey = "com.tencent.atomicx.bridge.encodeNanos"
+
+    public private(set) var isEnabled = false
+
+    private let lock = NSLock()
+    private var stats: [String: KeyStats] = [:]
+    private var startedAt = DispatchTime.now().uptimeNanoseconds
+
+    public func setEnabled(_ enabled: Bool) {
+        lock.lock()
+        defer { lock.unlock() }
+        if enabled && !isEnabled {
+            stats.removeAll()
+            startedAt = DispatchTime.now().uptimeNanoseconds
+        }
+        isEnabled = enabled
+    }
+
+    /// 累计当前线程上的编码耗时，由随后在同一线程上的 recordEmission 归到对应的 key
+    public func recordEncode(nanos: UInt64) {
+        guard isEnabled else { return }
+        let dict = Thread.current.threadDictionary
+        dict[BridgeMetrics.encodeNanosKey] = ((dict[BridgeMetrics.encodeNanosKey] as? UInt64) ?? 0) + nanos
+    }
+
+    /// 记录一次 store 事件下发（已通过去重与限频，即将切回主线程）
+    public func recordEmission(store: String, key: String, data: String) {
+        guard isEnabled else { return }
+        let encodeNanos = takeEncodeNanos()
+        let now = DispatchTime.now().uptimeNanoseconds
+        lock.lock()
+        defer { lock.unlock() }
+        keyStats(store: store, key: key).record(at: now, bytes: data.utf8.count, encodeNanos: encodeNanos)
+    }
+
+    /// 记录一次因与上次内容相同被去重丢弃的事件，编码耗时仍计入该 key
+    public func recordSuppressed(store: String, key: String) {
+        recordDropped(store: store, key: key, coalesced: false)
+    }
+
+    /// 记录一次被限频合并（被更新的值覆盖、不会下发）的事件
+    public func recordCoalesced(store: String, key: String) {
+        recordDropped(store: store, key: key, coalesced: true)
+    }
+
+    private func recordDropped(store: String, key: String, coalesced: Bool) {
+        guard isEnabled else { return }
+        let encodeNanos = takeEncodeNanos()
+        lock.lock()
+        defer { lock.unlock() }
+        keyStats(store: store, key: key).recordDropped(encodeNanos: encodeNanos, coalesced: coalesced)
+    }
+
+    private func takeEncodeNanos() -> UInt64 {
+        let dict = Thread.current.threadDictionary
+        let encodeNanos = (dict[BridgeMetrics.encodeNanosKey] as? UInt64) ?? 0
+        dict.removeObject(forKey: BridgeMetrics.encodeNanosKey)
+        return encodeNanos
+    }
+
+    /// 调用方需持有 lock
+    private func keyStats(store: String, key: String) -> KeyStats {
+        let id = "\(store).\(key)"
+        if let keyStats = stats[id] {
+            return keyStats
+        }
+        let keyStats = KeyStats()
+        stats[id] = keyStats
+        return keyStats
+    }
+
+    public func metrics() -> [String: Any] {
+        lock.lock()
+        defer { lock.unlock() }
+        return [
+            "enabled": isEnabled,
+            "elapsedMs": Double(DispatchTime.now().uptimeNanoseconds - startedAt) / 1_000_000,
+            "keys": stats.mapValues { $0.snapshot() },
+        ]
+    }
+
+    public func metricsJson() -> String {
+        return JsonUtil.toJson(metrics()) ?? "{}"
+    }
+}
+
+/// 单个 (store, key) 的累计值与最近样本环
+private final class KeyStats {
+    private var count: UInt64 = 0
+    private var suppressed: UInt64 = 0
+    private var coalesced: UInt64 = 0
+    private var totalBytes: UInt64 = 0
+    private var totalEncodeNanos: UInt64 = 0
+    private var times: [UInt64] = []
+    private var bytes: [Int] = []
+    private var encodeNanos: [UInt64] = []
+    private var index = 0
+
+    func record(at time: UInt64, bytes size: Int, encodeNanos nanos: UInt64) {
+        count += 1
+        totalBytes += UInt64(size)
+        totalEncodeNanos += nanos
+        if times.count < BridgeMetrics.sampleCount {
+            times.append(time)
+            bytes.append(size)
+            encodeNanos.append(nanos)
+        } else {
+            times[index] = time
+            bytes[index] = size
+            encodeNanos[index] = nanos
+        }
+        index = (index + 1) % BridgeMetrics.sampleCount
+    }
+
+    func recordDropped(encodeNanos nanos: UInt64, coalesced isCoalesced: Bool) {
+        if isCoalesced {
+            coalesced += 1
+        } else {
+            suppressed += 1
+        }
+        totalEncodeNanos += nanos
+    }
+
+    func snapshot() -> [String: Any] {
+        let sortedBytes = bytes.sorted()
+        let sortedEncode = encodeNanos.sorted()
+        return [
+            "count": count,
+            "suppressed": suppressed,
+            "coalesced": coalesced,
+            "ratePerSec": rate(),
+            "totalBytes": totalBytes,
+            "bytesP50": percentile(sortedBytes, 50),
+            "bytesP95": percentile(sortedBytes, 95),
+            "encodeMs": Double(totalEncodeNanos) / 1_000_000,
+            "encodeP50Ms": Double(percentile(sortedEncode, 50)) / 1_000_000,
+            "encodeP95Ms": Double(percentile(sortedEncode, 95)) / 1_000_000,
+        ]
+    }
+
+    /// 最近样本窗口内的每秒下发次数
+    private func rate() -> Double {
+        guard let first = times.min(), let last = times.max(), last > first else {
+            return 0
+        }
+        return Double(times.count - 1) * 1_000_000_000 / Double(last - first)
+    }
+
+    private func percentile<T: BinaryInteger>(_ sorted: [T], _ p: Int) -> T {
+        if sorted.isEmpty {
+            return 0
+        }
+        return sorted[min(sorted.count - 1, sorted.count * p / 100)]
+    }
+}
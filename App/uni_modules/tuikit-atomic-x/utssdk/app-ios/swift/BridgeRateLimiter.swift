@@ -0,0 +1,127 @@
+import Combine
+import Foundation
+
+/// 高频 store 事件的限频下发：按 store + key 配置最大频率，窗口内只保留最新值并在窗口结束时补发，未配置的 key 立即下发
+public class BridgeRateLimiter {
+    public static let shared = BridgeRateLimiter()
+
+    private class KeyState {
+        var lastSentTime: TimeInterval = 0
+        var pendingData: String?
+        var isFlushScheduled = false
+    }
+
+    /// 每个包装回调（即每个直播间的订阅）独立的限频状态，避免不同房间的最新值互相覆盖
+    private class StateTable {
+        var states: [String: KeyState] = [:]
+        var isCancelled = false
+    }
+
+    private let lock = NSLock()
+    private var intervals: [String: TimeInterval] = [
+        "Device.currentMicVolume": 0.1,
+        "Device.captureVolume": 0.1,
+        "Device.networkInfo": 1.0,
+        "LiveSeat.speakingUsers": 0.1,
+    ]
+    private var coalescedCount: UInt64 = 0
+
+    /// 设置 store 事件的最大下发频率（次/秒），maxRate <= 0 时取消限频
+    public func setMaxRate(store: String, key: String, maxRate: Double) {
+        lock.lock()
+        defer { lock.unlock() }
+        let id = "\(store).\(key)"
+        if maxRate > 0 {
+            intervals[id] = 1.0 / maxRate
+        } else {
+            intervals.removeValue(forKey: id)
+        }
+    }
+
+    /// 包装 store 的回调：配置了频率的 key 按最新值合并下发，补发在该 store 的编码队列上执行，保持与其他事件的顺序。
+    /// 限频状态的生命周期绑定到订阅的 cancellables，取消订阅后等待中的补发直接丢弃
+    public func rateLimitedCallback(
+        store: String,
+        cancellables: inout Set<AnyCancellable>,
+        _ callback: @escaping (_ name: String, _ data: String) -> Void
+    ) -> (_ name: String, _ data: String) -> Void {
+        let table = StateTable()
+        AnyCancellable { [weak self] in
+            self?.lock.lock()
+            table.isCancelled = true
+            table.states.removeAll()
+            self?.lock.unlock()
+        }.store(in: &cancellables)
+        return { [weak self] name, data in
+            guard let self = self else { return }
+            self.deliver(store: store, name: name, data: data, table: table, callback: callback)
+        }
+    }
+
+    /// 被合并掉（未下发）的事件数
+    public func coalescedEventCount() -> UInt64 {
+        lock.lock()
+        defer { lock.unlock() }
+        return coalescedCount
+    }
+
+    private func deliver(store: String, name: String, data: String, table: StateTable,
+                         callback: @escaping (_ name: String, _ data: String) -> Void) {
+        let id = "\(store).\(name)"
+        lock.lock()
+        if table.isCancelled {
+            lock.unlock()
+            return
+        }
+        guard let interval = intervals[id] else {
+            lock.unlock()
+            callback(name, data)
+            return
+        }
+        let state: KeyState
+        if let existing = table.states[name] {
+            state = existing
+        } else {
+            state = KeyState()
+            table.states[name] = state
+        }
+        let now = ProcessInfo.processInfo.systemUptime
+        if !state.isFlushScheduled && now - state.lastSentTime >= interval {
+            state.lastSentTime = now
+            lock.unlock()
+            callback(name, data)
+            return
+        }
+        if state.pendingData != nil {
+            coalescedCount += 1
+            BridgeMetrics.shared.recordCoalesced(store: store, key: name)
+        }
+        state.pendingData = data
+        if state.isFlushScheduled {
+            lock.unlock()
+            return
+        }
+        state.isFlushScheduled = true
+        let delay = max(0, state.lastSentTime + interval - now)
+        lock.unlock()
+
+        BridgeEncoder.shared.queue(for: store).asyncAfter(deadline: .now() + delay) { [weak self] in
+            self?.flush(state: state, table: table, name: name, callback: callback)
+        }
+    }
+
+    private func flush(state: KeyState, table: StateTable, name: String,
+                       callback: @escaping (_ name: String, _ data: String) -> Void) {
+        lock.lock()
+        guard !table.isCancelled, let data = state.pendingData else {
+            state.isFlushScheduled = false
+            lock.unlock()
+            return
+        }
+        state.pendingData = nil
+        state.isFlushScheduled = false
+        state.lastSentTime = ProcessInfo.processInfo.systemUptime
+        lock.unlock()
+        callback(name, data)
+    }
+}
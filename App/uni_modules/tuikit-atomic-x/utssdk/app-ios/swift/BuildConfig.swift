@@ -0,0 +1,12 @@
+import Foundation
+
+/// 宿主 App 的编译配置，插件 Swift 源码随宿主工程编译，DEBUG 与宿主的 Debug 配置一致
+public class BuildConfig {
+    public static func isDebugBuild() -> Bool {
+        #if DEBUG
+        return true
+        #else
+        return false
+        #endif
+    }
+}
@@ -0,0 +1,102 @@
+import Foundation
+
+/// store 命令执行器：不涉及 UI 的 SDK 调用在专用串行队列上按调用顺序执行，避免排在主线程的布局与动画之后；
+/// 视图相关操作（LiveRenderView、SVGAAnimationView 等）仍在主线程执行。
+///
+/// 线程约定：
+/// - 命令队列：`XxxStore.create(liveID:)`/`LiveListStore.shared` 取实例并调用其命令方法（takeSeat、sendTextMessage 等），
+///   结果通过 SDK 的 completion 回调返回，回调线程不固定，回调中不直接修改命令读取的状态
+/// - 主线程：视图操作、observer 的 Combine 订阅与取消、事件监听的注册与移除（LiveEventDispatcher 非线程安全）
+/// - 命令与 observer 共享的状态只在一个队列上读写：currentLiveID 在命令队列（通过 post 写入），
+///   观众名单窗口大小在 LiveAudience 编码队列（通过 setAudienceWindowSize 写入）
+public class CommandExecutor {
+    public static let shared = CommandExecutor()
+
+    /// 最近等待耗时的采样数，用于计算 p95
+    private static let waitSampleCount = 256
+    /// 等待超过该值的命令计入 slowWaitCount
+    private static let slowWaitNanos: UInt64 = 100_000_000
+
+    private let queue = DispatchQueue(label: "com.tencent.atomicx.command", qos: .userInitiated)
+    private let lock = NSLock()
+
+    private var depth = 0
+    private var maxDepth = 0
+    private var executedCount: UInt64 = 0
+    private var slowWaitCount: UInt64 = 0
+    private var totalWaitNanos: UInt64 = 0
+    private var maxWaitNanos: UInt64 = 0
+    private var totalRunNanos: UInt64 = 0
+    private var waitSamples: [UInt64] = []
+    private var waitSampleIndex = 0
+
+    /// 提交命令，按提交顺序串行执行
+    public func execute(_ name: String, block: @escaping () -> Void) {
+        let enqueuedAt = DispatchTime.now().uptimeNanoseconds
+        lock.lock()
+        depth += 1
+        maxDepth = max(maxDepth, depth)
+        lock.unlock()
+
+        queue.async { [weak self] in
+            guard let self = self else { return }
+            let startedAt = DispatchTime.now().uptimeNanoseconds
+            let startedMicros = TraceRecorder.shared.isEnabled ? TraceRecorder.nowMicros() : 0
+            block()
+            let run = DispatchTime.now().uptimeNanoseconds - startedAt
+            self.record(name, wait: startedAt - enqueuedAt, run: run)
+            if startedMicros > 0 {
+                TraceRecorder.shared.complete(name: name, category: "command", threadID: TraceRecorder.commandThreadID,
+                                              startMicros: startedMicros, durationMicros: Int64(run / 1000),
+                                              args: ["waitMs": String(Double(startedAt - enqueuedAt) / 1_000_000)])
+            }
+        }
+    }
+
+    /// 在命令队列上执行状态更新（如 SDK 回调中写入命令读取的状态），不计入命令指标
+    public func post(block: @escaping () -> Void) {
+        queue.async(execute: block)
+    }
+
+    private func record(_ name: String, wait: UInt64, run: UInt64) {
+        lock.lock()
+        defer { lock.unlock() }
+        depth -= 1
+        executedCount += 1
+        totalWaitNanos += wait
+        totalRunNanos += run
+        maxWaitNanos = max(maxWaitNanos, wait)
+        if wait > CommandExecutor.slowWaitNanos {
+            slowWaitCount += 1
+            print("CommandExecutor slow command: \(name), waitMs: \(Double(wait) / 1_000_000)")
+        }
+        if waitSamples.count < CommandExecutor.waitSampleCount {
+            waitSamples.append(wait)
+        } else {
+            waitSamples[waitSampleIndex] = wait
+        }
+        waitSampleIndex = (waitSampleIndex + 1) % CommandExecutor.waitSampleCount
+    }
+
+    public func metrics() -> [String: Any] {
+        lock.lock()
+        defer { lock.unlock() }
+        let sorted = waitSamples.sorted()
+        let p95 = sorted.isEmpty ? 0 : sorted[min(sorted.count - 1, sorted.count * 95 / 100)]
+        let count = max(executedCount, 1)
+        return [
+            "queueDepth": depth,
+            "maxQueueDepth": maxDepth,
+            "executedCount": executedCount,
+            "slowWaitCount": slowWaitCount,
+            "avgWaitMs": Double(totalWaitNanos / count) / 1_000_000,
+            "p95WaitMs": Double(p95) / 1_000_000,
+            "maxWaitMs": Double(maxWaitNanos) / 1_000_000,
+            "avgRunMs": Double(totalRunNanos / count) / 1_000_000,
+        ]
+    }
+
+    public func metricsJson() -> String {
+        return JsonUtil.toJson(metrics()) ?? "{}"
+    }
+}
@@ -3,6 +3,11 @@ import Foundation
 
 public class JsonUtil {
     public static func toJson(_ object: Any) -> String? {
+        let start = DispatchTime.now().uptimeNanoseconds
+        defer {
+            BridgeEncoder.shared.recordEncode(
+                nanos: DispatchTime.now().uptimeNanoseconds - start, onMainThread: Thread.isMainThread)
+        }
         guard let jsonData = try? JSONSerialization.data(withJSONObject: object, options: .fragmentsAllowed),
             let jsonString = String(data: jsonData, encoding: .utf8)
         else {
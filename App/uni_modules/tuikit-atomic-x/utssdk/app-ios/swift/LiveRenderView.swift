@@ -62,6 +62,12 @@ public class LiveRenderView: UIView {
 
         console.log("iOS-LiveRenderView, updateRenderView, viewType: ", self.nativeViewType)
         if let liveIDStr = liveID as? String , !liveIDStr.isEmpty {
+            let startedMicros = TraceRecorder.nowMicros()
+            defer {
+                TraceRecorder.shared.complete(name: "renderViewAttach", category: "view", threadID: TraceRecorder.mainThreadID,
+                                              startMicros: startedMicros, durationMicros: TraceRecorder.nowMicros() - startedMicros,
+                                              args: ["liveID": liveIDStr, "viewType": "\(self.nativeViewType)"])
+            }
             let renderView = LiveCoreView(viewType: self.nativeViewType, frame : .zero)
             renderView.setLiveID(liveIDStr)
             renderView.translatesAutoresizingMaskIntoConstraints = false
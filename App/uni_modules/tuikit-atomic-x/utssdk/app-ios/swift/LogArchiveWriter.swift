@@ -0,0 +1,204 @@
+import Compression
+import Foundation
+
+enum LogArchiveError: Error {
+    case openFailed
+    case compressionFailed
+}
+
+/// 日志导出使用的 zip 归档写入器：逐个文件分块 deflate 写出，本地文件头之后用数据描述符记录 CRC 与大小，
+/// 不需要回写文件头，内存占用与日志大小无关。格式与 Android 端 ZipOutputStream 的输出一致
+final class LogArchiveWriter {
+    private static let chunkSize = 64 * 1024
+    private static let crcTable: [UInt32] = (0..<256).map { index in
+        var crc = UInt32(index)
+        for _ in 0..<8 {
+            crc = (crc & 1) != 0 ? 0xEDB8_8320 ^ (crc >> 1) : crc >> 1
+        }
+        return crc
+    }
+
+    private let handle: FileHandle
+    private var centralDirectory = Data()
+    private var entryCount: UInt16 = 0
+    private(set) var bytesWritten: UInt64 = 0
+
+    init(path: String) throws {
+        guard FileManager.default.createFile(atPath: path, contents: nil),
+              let handle = FileHandle(forWritingAtPath: path) else {
+            throw LogArchiveError.openFailed
+        }
+        self.handle = handle
+    }
+
+    /// 写入一个文件，onRead 回调每次读取的未压缩字节数
+    func addFile(name: String, path: String, modifiedAt: Date, onRead: (Int) -> Void) throws {
+        guard let input = FileHandle(forReadingAtPath: path) else {
+            throw LogArchiveError.openFailed
+        }
+        defer { input.closeFile() }
+        try writeEntry(name: name, modifiedAt: modifiedAt) {
+            let chunk = input.readData(ofLength: LogArchiveWriter.chunkSize)
+            guard !chunk.isEmpty else { return nil }
+            onRead(chunk.count)
+            return chunk
+        }
+    }
+
+    func addData(name: String, data: Data) throws {
+        var pending: Data? = data
+        try writeEntry(name: name, modifiedAt: Date()) {
+            defer { pending = nil }
+            return pending
+        }
+    }
+
+    /// 写入中央目录并关闭文件
+    func finish() {
+        let centralDirectoryOffset = bytesWritten
+        write(centralDirectory)
+        var end = Data()
+        end.appendLittleEndian(UInt32(0x0605_4B50))
+        end.appendLittleEndian(UInt16(0))
+        end.appendLittleEndian(UInt16(0))
+        end.appendLittleEndian(entryCount)
+        end.appendLittleEndian(entryCount)
+        end.appendLittleEndian(UInt32(truncatingIfNeeded: centralDirectory.count))
+        end.appendLittleEndian(UInt32(truncatingIfNeeded: centralDirectoryOffset))
+        end.appendLittleEndian(UInt16(0))
+        write(end)
+        handle.closeFile()
+    }
+
+    /// 放弃写入，关闭文件，由调用方删除
+    func close() {
+        handle.closeFile()
+    }
+
+    private func writeEntry(name: String, modifiedAt: Date, nextChunk: () -> Data?) throws {
+        let localHeaderOffset = bytesWritten
+        let nameData = Data(name.utf8)
+        let (dosTime, dosDate) = LogArchiveWriter.dosDateTime(modifiedAt)
+
+        var header = Data()
+        header.appendLittleEndian(UInt32(0x0403_4B50))
+        header.appendLittleEndian(UInt16(20))
+        header.appendLittleEndian(UInt16(0x0808)) // 数据描述符 + UTF-8 文件名
+        header.appendLittleEndian(UInt16(8)) // deflate
+        header.appendLittleEndian(dosTime)
+        header.appendLittleEndian(dosDate)
+        header.appendLittleEndian(UInt32(0))
+        header.appendLittleEndian(UInt32(0))
+        header.appendLittleEndian(UInt32(0))
+        header.appendLittleEndian(UInt16(nameData.count))
+        header.appendLittleEndian(UInt16(0))
+        header.append(nameData)
+        write(header)
+
+        var crc: UInt32 = 0
+        var uncompressedSize: UInt64 = 0
+        let compressedStart = bytesWritten
+        try deflate {
+            guard let chunk = nextChunk() else { return nil }
+            crc = LogArchiveWriter.crc32(chunk, crc)
+            uncompressedSize += UInt64(chunk.count)
+            return chunk
+        }
+        let compressedSize = bytesWritten - compressedStart
+
+        var descriptor = Data()
+        descriptor.appendLittleEndian(UInt32(0x0807_4B50))
+        descriptor.appendLittleEndian(crc)
+        descriptor.appendLittleEndian(UInt32(truncatingIfNeeded: compressedSize))
+        descriptor.appendLittleEndian(UInt32(truncatingIfNeeded: uncompressedSize))
+        write(descriptor)
+
+        centralDirectory.appendLittleEndian(UInt32(0x0201_4B50))
+        centralDirectory.appendLittleEndian(UInt16(20))
+        centralDirectory.appendLittleEndian(UInt16(20))
+        centralDirectory.appendLittleEndian(UInt16(0x0808))
+        centralDirectory.appendLittleEndian(UInt16(8))
+        centralDirectory.appendLittleEndian(dosTime)
+        centralDirectory.appendLittleEndian(dosDate)
+        centralDirectory.appendLittleEndian(crc)
+        centralDirectory.appendLittleEndian(UInt32(truncatingIfNeeded: compressedSize))
+        centralDirectory.appendLittleEndian(UInt32(truncatingIfNeeded: uncompressedSize))
+        centralDirectory.appendLittleEndian(UInt16(nameData.count))
+        centralDirectory.appendLittleEndian(UInt16(0))
+        centralDirectory.appendLittleEndian(UInt16(0))
+        centralDirectory.appendLittleEndian(UInt16(0))
+        centralDirectory.appendLittleEndian(UInt16(0))
+        centralDirectory.appendLittleEndian(UInt32(0))
+        centralDirectory.appendLittleEndian(UInt32(truncatingIfNeeded: localHeaderOffset))
+        centralDirectory.append(nameData)
+        entryCount += 1
+    }
+
+    /// COMPRESSION_ZLIB 输出为不带 zlib 头的 raw deflate，即 zip 的 method 8
+    private func deflate(nextChunk: () -> Data?) throws {
+        let stream = UnsafeMutablePointer<compression_stream>.allocate(capacity: 1)
+        defer { stream.deallocate() }
+        guard compression_stream_init(stream, COMPRESSION_STREAM_ENCODE, COMPRESSION_ZLIB) == COMPRESSION_STATUS_OK else {
+            throw LogArchiveError.compressionFailed
+        }
+        defer { compression_stream_destroy(stream) }
+        let output = UnsafeMutablePointer<UInt8>.allocate(capacity: LogArchiveWriter.chunkSize)
+        defer { output.deallocate() }
+
+        var finished = false
+        while !finished {
+            let chunk = nextChunk()
+            let flags = chunk == nil ? Int32(COMPRESSION_STREAM_FINALIZE.rawValue) : 0
+            let input = chunk ?? Data()
+            try input.withUnsafeBytes { (raw: UnsafeRawBufferPointer) in
+                stream.pointee.src_ptr = raw.bindMemory(to: UInt8.self).baseAddress ?? UnsafePointer(output)
+                stream.pointee.src_size = input.count
+                repeat {
+                    stream.pointee.dst_ptr = output
+                    stream.pointee.dst_size = LogArchiveWriter.chunkSize
+                    let status = compression_stream_process(stream, flags)
+                    if status == COMPRESSION_STATUS_ERROR {
+                        throw LogArchiveError.compressionFailed
+                    }
+                    let produced = LogArchiveWriter.chunkSize - stream.pointee.dst_size
+                    if produced > 0 {
+                        write(Data(bytes: output, count: produced))
+                    }
+                    if status == COMPRESSION_STATUS_END {
+                        finished = true
+                    }
+                } while stream.pointee.src_size > 0 || (flags != 0 && !finished)
+            }
+        }
+    }
+
+    private func write(_ data: Data) {
+        handle.write(data)
+        bytesWritten += UInt64(data.count)
+    }
+
+    private static func crc32(_ data: Data, _ crc: UInt32) -> UInt32 {
+        var value = ~crc
+        data.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) in
+            for byte in bytes {
+                value = crcTable[Int((value ^ UInt32(byte)) & 0xFF)] ^ (value >> 8)
+            }
+        }
+        return ~value
+    }
+
+    private static func dosDateTime(_ date: Date) -> (UInt16, UInt16) {
+        let components = Calendar.current.dateComponents([.year, .month, .day, .hour, .minute, .second], from: date)
+        let year = max((components.year ?? 1980) - 1980, 0)
+        let time = (components.hour ?? 0) << 11 | (components.minute ?? 0) << 5 | (components.second ?? 0) / 2
+        let day = year << 9 | (components.month ?? 1) << 5 | (components.day ?? 1)
+        return (UInt16(truncatingIfNeeded: time), UInt16(truncatingIfNeeded: day))
+    }
+}
+
+private extension Data {
+    mutating func appendLittleEndian<T: FixedWidthInteger>(_ value: T) {
+        var littleEndian = value.littleEndian
+        Swift.withUnsafeBytes(of: &littleEndian) { append(contentsOf: $0) }
+    }
+}
@@ -9,16 +9,48 @@ import DCloudUTSFoundation
 public class FileModel {
     var fileName: String
     var filePath: String
+    var source: String = ""
+    var size: UInt64 = 0
+    /// 日志时间范围（毫秒），起始为文件创建时间，结束为最后修改时间
+    var startTime: Int64 = 0
+    var endTime: Int64 = 0
     
     init(fileName: String, filePath: String) {
         self.fileName = fileName
         self.filePath = filePath
     }
+
+    func overlaps(startTime: Int64, endTime: Int64) -> Bool {
+        return self.endTime >= startTime && self.startTime <= endTime
+    }
+
+    func toJson() -> [String: Any] {
+        return ["name": fileName, "path": filePath, "source": source, "size": size,
+                "startTime": startTime, "endTime": endTime]
+    }
+}
+
+/// 日志来源：目录与日志文件扩展名
+private struct LogSource {
+    let name: String
+    let directory: String
+    let extensions: [String]
 }
 
+/// 日志导出：增量维护日志文件索引（大小、时间范围、来源），按时间窗口筛选后在后台队列流式压缩为一个 zip，
+/// 总大小受上限约束。归档内第一个文件为 manifest.json，日志文件按 <source>/<fileName> 存放，与 Android 端格式一致
 public class LogUpload {
     public static let shared = LogUpload()
+    private static let defaultMaxBytes: Int64 = 50 * 1024 * 1024
+    private static let archivePrefix = "atomicx_logs_"
+
     private var fileModelArray: [FileModel] = []
+    private let queue = DispatchQueue(label: "com.tencent.atomicx.logupload")
+    // 以下状态只在 queue 上访问
+    private var index: [String: FileModel] = [:]
+    private var directoryModifiedAt: [String: Date] = [:]
+    private var directoryFiles: [String: [String]] = [:]
+    private var isExporting = false
     
     public func shareLog(_ row: Int){
         if row < self.fileModelArray.count {
@@ -36,28 +68,174 @@ public class LogUpload {
     }
     
     public func fetchLogfileList() -> [FileModel] {
-        var fileArray: [FileModel] = []
-        guard let documentsPath = NSSearchPathForDirectoriesInDomains(.documentDirectory, .userDomainMask, true).first
-        else { return []}
-        
-        let logPath = (documentsPath as NSString).appendingPathComponent("log")
-        guard let libraryPath = NSSearchPathForDirectoriesInDomains(.libraryDirectory, .userDomainMask, true).first
-        else { return []}
-        
-        let cachePath = (libraryPath as NSString).appendingPathComponent("Caches/com_tencent_imsdk_log")
-        let liteAVSDKClogFiles = getFilesFromDirectory(atPath: logPath, withExtension: ".clog")
-        fileArray += liteAVSDKClogFiles
-        let liteAVSDKXlogFiles = getFilesFromDirectory(atPath: logPath, withExtension: ".xlog")
-        fileArray += liteAVSDKXlogFiles
-        let imXlogFiles = getFilesFromDirectory(atPath: cachePath, withExtension: ".xlog")
-        fileArray += imXlogFiles
-        
-        fileModelArray = fileArray
+        fileModelArray = queue.sync { refreshIndex() }
         console.log("LogUpload, fileModelArray count:", fileModelArray.count)
         // 打印详细日志
 //        printLogFile()
         return fileModelArray
     }
+
+    /// 在后台队列刷新索引，回调时间窗口内的日志文件 JSON 数组（按结束时间倒序），时间为毫秒，小于等于 0 表示不限
+    public func fetchLogFiles(startTime: Int64, endTime: Int64, completion: @escaping (String) -> Void) {
+        queue.async {
+            let (from, to) = LogUpload.timeWindow(startTime: startTime, endTime: endTime)
+            let files = self.refreshIndex().filter { $0.overlaps(startTime: from, endTime: to) }
+            let json = LogUpload.jsonString(files.map { $0.toJson() }) ?? "[]"
+            DispatchQueue.main.async { completion(json) }
+        }
+    }
+
+    /// 导出时间窗口内的日志为 zip：按结束时间从新到旧选取，未压缩总大小不超过 maxBytes（小于等于 0 时为 50MB），
+    /// 超出的文件记入 manifest 的 skipped。progress 为 0~1，completion 的 code 为 0 时 path 为归档路径
+    public func exportLogs(startTime: Int64, endTime: Int64, maxBytes: Int64,
+                           progress: @escaping (Double) -> Void,
+                           completion: @escaping (_ code: Int, _ message: String, _ path: String) -> Void) {
+        queue.async {
+            guard !self.isExporting else {
+                DispatchQueue.main.async { completion(-1, "export in progress", "") }
+                return
+            }
+            self.isExporting = true
+            defer { self.isExporting = false }
+
+            let (from, to) = LogUpload.timeWindow(startTime: startTime, endTime: endTime)
+            let budget = maxBytes > 0 ? maxBytes : LogUpload.defaultMaxBytes
+            var selected: [FileModel] = []
+            var skipped: [FileModel] = []
+            var totalBytes: Int64 = 0
+            for file in self.refreshIndex() where file.overlaps(startTime: from, endTime: to) {
+                if totalBytes + Int64(file.size) > budget {
+                    skipped.append(file)
+                    continue
+                }
+                selected.append(file)
+                totalBytes += Int64(file.size)
+            }
+            guard !selected.isEmpty else {
+                DispatchQueue.main.async { completion(-2, "no log files in range", "") }
+                return
+            }
+
+            let path = LogUpload.newArchivePath()
+            do {
+                let writer = try LogArchiveWriter(path: path)
+                let manifest: [String: Any] = [
+                    "version": 1,
+                    "platform": "ios",
+                    "createdAt": Int64(Date().timeIntervalSince1970 * 1000),
+                    "startTime": from,
+                    "endTime": to,
+                    "maxBytes": budget,
+                    "files": selected.map { $0.toJson() },
+                    "skipped": skipped.map { $0.toJson() },
+                ]
+                do {
+                    try writer.addData(name: "manifest.json", data: Data((LogUpload.jsonString(manifest) ?? "{}").utf8))
+                    var readBytes: Int64 = 0
+                    var reportedPercent = -1
+                    for file in selected {
+                        let modifiedAt = Date(timeIntervalSince1970: Double(file.endTime) / 1000)
+                        try writer.addFile(name: "\(file.source)/\(file.fileName)", path: file.filePath, modifiedAt: modifiedAt) { count in
+                            readBytes += Int64(count)
+                            let percent = Int(min(readBytes * 100 / max(totalBytes, 1), 100))
+                            if percent != reportedPercent {
+                                reportedPercent = percent
+                                DispatchQueue.main.async { progress(Double(percent) / 100) }
+                            }
+                        }
+                    }
+                    writer.finish()
+                } catch {
+                    writer.close()
+                    throw error
+                }
+                console.log("LogUpload, exported:", path, "files:", selected.count, "skipped:", skipped.count)
+                DispatchQueue.main.async { completion(0, "", path) }
+            } catch {
+                try? FileManager.default.removeItem(atPath: path)
+                DispatchQueue.main.async { completion(-3, "export failed: \(error)", "") }
+            }
+        }
+    }
+
+    /// 通过系统分享面板分享导出的归档
+    public func shareLogArchive(_ path: String) {
+        DispatchQueue.main.async {
+            let activityView = UIActivityViewController(activityItems: [URL(fileURLWithPath: path)], applicationActivities: nil)
+            guard let curVC = self.getCurrentWindowViewController() else { return }
+            curVC.present(activityView, animated: true) {}
+        }
+    }
+
+    private func logSources() -> [LogSource] {
+        var sources: [LogSource] = []
+        if let documentsPath = NSSearchPathForDirectoriesInDomains(.documentDirectory, .userDomainMask, true).first {
+            sources.append(LogSource(name: "liteav", directory: (documentsPath as NSString).appendingPathComponent("log"),
+                                     extensions: [".clog", ".xlog"]))
+        }
+        if let libraryPath = NSSearchPathForDirectoriesInDomains(.libraryDirectory, .userDomainMask, true).first {
+            sources.append(LogSource(name: "imsdk",
+                                     directory: (libraryPath as NSString).appendingPathComponent("Caches/com_tencent_imsdk_log"),
+                                     extensions: [".xlog"]))
+        }
+        return sources
+    }
+
+    /// 增量刷新索引：目录修改时间未变时不重新列目录，文件大小与修改时间未变时复用已有条目。只在 queue 上调用
+    private func refreshIndex() -> [FileModel] {
+        let fileManager = FileManager.default
+        var alive = Set<String>()
+        for source in logSources() {
+            let directoryModified = (try? fileManager.attributesOfItem(atPath: source.directory))?[.modificationDate] as? Date
+            var names = directoryFiles[source.directory]
+            if names == nil || directoryModified != directoryModifiedAt[source.directory] {
+                names = getFilesFromDirectory(atPath: source.directory, withExtensions: source.extensions)
+                directoryFiles[source.directory] = names
+                directoryModifiedAt[source.directory] = directoryModified
+            }
+            for fileName in names ?? [] {
+                let filePath = (source.directory as NSString).appendingPathComponent(fileName)
+                guard let attributes = try? fileManager.attributesOfItem(atPath: filePath) else { continue }
+                let size = (attributes[.size] as? NSNumber)?.uint64Value ?? 0
+                let modifiedAt = (attributes[.modificationDate] as? Date) ?? Date()
+                let endTime = Int64(modifiedAt.timeIntervalSince1970 * 1000)
+                alive.insert(filePath)
+                if let entry = index[filePath], entry.size == size, entry.endTime == endTime {
+                    continue
+                }
+                let entry = index[filePath] ?? FileModel(fileName: fileName, filePath: filePath)
+                let createdAt = (attributes[.creationDate] as? Date) ?? modifiedAt
+                entry.source = source.name
+                entry.size = size
+                entry.startTime = min(Int64(createdAt.timeIntervalSince1970 * 1000), endTime)
+                entry.endTime = endTime
+                index[filePath] = entry
+            }
+        }
+        index = index.filter { alive.contains($0.key) }
+        return index.values.sorted { $0.endTime > $1.endTime }
+    }
+
+    private static func timeWindow(startTime: Int64, endTime: Int64) -> (Int64, Int64) {
+        return (max(startTime, 0), endTime > 0 ? endTime : Int64.max)
+    }
+
+    /// 归档放在临时目录，生成新归档前删除之前导出的归档
+    private static func newArchivePath() -> String {
+        let directory = NSTemporaryDirectory()
+        let fileManager = FileManager.default
+        for name in (try? fileManager.contentsOfDirectory(atPath: directory)) ?? [] where name.hasPrefix(archivePrefix) {
+            try? fileManager.removeItem(atPath: (directory as NSString).appendingPathComponent(name))
+        }
+        let formatter = DateFormatter()
+        formatter.dateFormat = "yyyyMMdd-HHmmss"
+        return (directory as NSString).appendingPathComponent("\(archivePrefix)\(formatter.string(from: Date())).zip")
+    }
+
+    private static func jsonString(_ object: Any) -> String? {
+        guard let data = try? JSONSerialization.data(withJSONObject: object) else { return nil }
+        return String(data: data, encoding: .utf8)
+    }
     
     private func printLogFile(){
         if fileModelArray.isEmpty {
@@ -71,17 +249,15 @@ public class LogUpload {
     }
     
     /// 解析日志文件夹
-    private func getFilesFromDirectory(atPath path: String, withExtension fileExtension: String) -> [FileModel] {
+    private func getFilesFromDirectory(atPath path: String, withExtensions fileExtensions: [String]) -> [String] {
         let fileManager = FileManager.default
-        var files: [FileModel] = []
+        var files: [String] = []
 
         do {
             let contents = try fileManager.contentsOfDirectory(atPath: path)
             for fileName in contents {
-               if fileName.hasSuffix(fileExtension) {
-                   let filePath = (path as NSString).appendingPathComponent(fileName)
-                   let file = FileModel(fileName: fileName, filePath: filePath)
-                   files.append(file)
+               if fileExtensions.contains(where: { fileName.hasSuffix($0) }) {
+                   files.append(fileName)
                }
             }
         } catch {
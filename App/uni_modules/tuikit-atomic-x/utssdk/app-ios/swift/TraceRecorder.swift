@@ -0,0 +1,100 @@
+import Foundation
+
+/// 链路追踪：native 侧的命令执行、store 首次下发、渲染视图挂载写入固定大小的环形缓冲区，
+/// 由 JS 侧合并导出为 Chrome trace_event JSON。时间戳为 Unix 微秒，与 JS 侧对齐
+public class TraceRecorder {
+    public static let shared = TraceRecorder()
+
+    /// 环形缓冲区容量，写满后覆盖最旧的事件
+    private static let capacity = 2048
+    /// trace_event 中的线程编号，按事件来源区分
+    public static let mainThreadID = 1
+    public static let commandThreadID = 2
+    public static let storeThreadID = 3
+
+    private struct TraceEvent {
+        let name: String
+        let category: String
+        let phase: String
+        let timestamp: Int64
+        let duration: Int64
+        let threadID: Int
+        let args: [String: String]
+    }
+
+    public private(set) var isEnabled = true
+
+    private let lock = NSLock()
+    private var events: [TraceEvent] = []
+    private var nextIndex = 0
+
+    public static func nowMicros() -> Int64 {
+        return Int64(Date().timeIntervalSince1970 * 1_000_000)
+    }
+
+    public func setEnabled(_ enabled: Bool) {
+        isEnabled = enabled
+    }
+
+    /// 记录有起止时间的事件（ph = X）
+    public func complete(name: String, category: String, threadID: Int, startMicros: Int64, durationMicros: Int64,
+                         args: [String: String] = [:]) {
+        guard isEnabled else { return }
+        append(TraceEvent(name: name, category: category, phase: "X", timestamp: startMicros,
+                          duration: durationMicros, threadID: threadID, args: args))
+    }
+
+    /// 记录瞬时事件（ph = i）
+    public func instant(name: String, category: String, threadID: Int, args: [String: String] = [:]) {
+        guard isEnabled else { return }
+        append(TraceEvent(name: name, category: category, phase: "i", timestamp: TraceRecorder.nowMicros(),
+                          duration: 0, threadID: threadID, args: args))
+    }
+
+    public func clear() {
+        lock.lock()
+        defer { lock.unlock() }
+        events.removeAll()
+        nextIndex = 0
+    }
+
+    /// 按时间先后导出 trace_event 数组（不含 pid，由 JS 侧合并时填写）
+    public func eventsJson() -> String {
+        lock.lock()
+        let ordered = events.count < TraceRecorder.capacity
+            ? events : Array(events[nextIndex...] + events[..<nextIndex])
+        lock.unlock()
+        let array: [[String: Any]] = ordered.map { event in
+            var item: [String: Any] = [
+                "name": event.name,
+                "cat": event.category,
+                "ph": event.phase,
+                "ts": event.timestamp,
+                "tid": event.threadID,
+                "args": event.args,
+            ]
+            if event.phase == "X" {
+                item["dur"] = event.duration
+            } else {
+                item["s"] = "t"
+            }
+            return item
+        }
+        guard let data = try? JSONSerialization.data(withJSONObject: array),
+              let json = String(data: data, encoding: .utf8) else {
+            return "[]"
+        }
+        return json
+    }
+
+    private func append(_ event: TraceEvent) {
+        lock.lock()
+        defer { lock.unlock() }
+        if events.count < TraceRecorder.capacity {
+            events.append(event)
+        } else {
+            events[nextIndex] = event
+        }
+        nextIndex = (nextIndex + 1) % TraceRecorder.capacity
+    }
+}
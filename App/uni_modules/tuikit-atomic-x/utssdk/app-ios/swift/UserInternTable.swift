@@ -0,0 +1,89 @@
+import AtomicXCore
+import Foundation
+
+/// 用户资料驻留表：按 userID + 资料版本分配数字句柄，资料只在首次出现或变更时随 userProfiles 事件下发一次，
+/// 之后 messageList、audienceList 中的用户只携带句柄，JS 侧通过 utils/userTable.ts 还原
+public class UserInternTable {
+    public static let shared = UserInternTable()
+
+    /// 最小容量：一次 messageListReset/audienceList 的用户需同时驻留，否则同一批内分配的句柄会在 JS 还原前被淘汰
+    public static let minCapacity = 100
+
+    private struct Entry {
+        let handle: Int
+        let userName: String
+        let avatarURL: String
+        var lastUsed: UInt64
+    }
+
+    /// 是否启用句柄下发，由 JS 侧通过 setUserInterning 开启
+    public private(set) var isEnabled = false
+
+    private let lock = NSLock()
+    private var entries: [String: Entry] = [:]
+    private var nextHandle = 1
+    private var tick: UInt64 = 0
+    private var capacity = 1000
+    private var pendingEvicted: [Int] = []
+
+    /// 开启或关闭句柄下发；每次调用都会清空驻留表，保证 JS 侧（可能已重新加载）重新收到完整资料。
+    /// capacity 小于 minCapacity 时按 minCapacity 生效，由调用方输出告警
+    public func setEnabled(_ enabled: Bool, capacity: Int) {
+        lock.lock()
+        defer { lock.unlock() }
+        isEnabled = enabled
+        self.capacity = max(UserInternTable.minCapacity, capacity)
+        entries.removeAll()
+        pendingEvicted.removeAll()
+    }
+
+    /// 为一批用户分配句柄。新出现或资料变更的用户会先通过 callback 下发 userProfiles，
+    /// 分配与下发在同一临界区内完成，保证其他 store 引用同一句柄时资料已先行投递到主线程
+    public func intern(
+        _ users: [LiveUserInfo], _ callback: @escaping (_ name: String, _ data: String) -> Void
+    ) -> [Int] {
+        lock.lock()
+        defer { lock.unlock() }
+        var profiles: [String: [String: String]] = [:]
+        let handles: [Int] = users.map { user in
+            tick += 1
+            let userID = user.userID
+            let userName = user.userName ?? ""
+            let avatarURL = user.avatarURL ?? ""
+            if var entry = entries[userID], entry.userName == userName, entry.avatarURL == avatarURL {
+                entry.lastUsed = tick
+                entries[userID] = entry
+                return entry.handle
+            }
+            if let stale = entries[userID] {
+                pendingEvicted.append(stale.handle)
+            }
+            let handle = nextHandle
+            nextHandle += 1
+            entries[userID] = Entry(handle: handle, userName: userName, avatarURL: avatarURL, lastUsed: tick)
+            profiles[String(handle)] = ["userID": userID, "userName": userName, "avatarURL": avatarURL]
+            return handle
+        }
+        evictIfNeeded()
+        if profiles.isEmpty && pendingEvicted.isEmpty {
+            return handles
+        }
+        let payload: [String: Any] = ["users": profiles, "evicted": pendingEvicted]
+        pendingEvicted.removeAll()
+        if let json = JsonUtil.toJson(payload) {
+            callback("userProfiles", json)
+        }
+        return handles
+    }
+
+    /// 超出容量时按最近使用时间淘汰约 10%，摊薄排序开销
+    private func evictIfNeeded() {
+        guard entries.count > capacity else { return }
+        let overflow = entries.count - capacity + capacity / 10
+        let victims = entries.sorted { $0.value.lastUsed < $1.value.lastUsed }.prefix(overflow)
+        for (userID, entry) in victims {
+            entries.removeValue(forKey: userID)
+            pendingEvicted.append(entry.handle)
+        }
+    }
+}
@@ -0,0 +1,88 @@
+import Foundation
+
+/// 紧凑传输格式的字段定义：按 schema 顺序输出字段值，不再重复携带 key 字符串
+public struct WireField {
+    let key: String
+    let nested: [WireField]?
+
+    init(_ key: String, _ nested: [WireField]? = nil) {
+        self.key = key
+        self.nested = nested
+    }
+}
+
+/// 高频 store 事件的紧凑编码，字段顺序须与 utils/wireCodec.ts 中的 WireSchema 保持一致
+public enum WireSchema {
+    /// 紧凑格式标记，作为 JSON 数组的第一个元素，JS 侧据此选择解码方式
+    public static let tag = "c1"
+
+    static let liveUserInfo: [WireField] = [
+        WireField("userID"), WireField("userName"), WireField("avatarURL"),
+    ]
+
+    static let seatUserInfo: [WireField] = [
+        WireField("userID"), WireField("userName"), WireField("avatarURL"), WireField("role"),
+        WireField("liveID"), WireField("microphoneStatus"), WireField("allowOpenMicrophone"),
+        WireField("cameraStatus"), WireField("allowOpenCamera"),
+    ]
+
+    static let region: [WireField] = [
+        WireField("x"), WireField("y"), WireField("w"), WireField("h"), WireField("zorder"),
+    ]
+
+    static let seatInfo: [WireField] = [
+        WireField("index"), WireField("isLocked"), WireField("userInfo", seatUserInfo),
+        WireField("region", region),
+    ]
+
+    static let barrage: [WireField] = [
+        WireField("liveID"), WireField("sender", liveUserInfo), WireField("sequence"),
+        WireField("timestampInSecond"), WireField("messageType"), WireField("textContent"),
+        WireField("extensionInfo"), WireField("businessID"), WireField("data"),
+    ]
+
+    static let liveInfo: [WireField] = [
+        WireField("liveID"), WireField("liveName"), WireField("notice"), WireField("isMessageDisable"),
+        WireField("isPublicVisible"), WireField("isSeatEnabled"), WireField("keepOwnerOnSeat"),
+        WireField("maxSeatCount"), WireField("seatMode"), WireField("seatLayoutTemplateID"),
+        WireField("coverURL"), WireField("backgroundURL"), WireField("activityStatus"),
+        WireField("liveOwner", liveUserInfo), WireField("createTime"), WireField("categoryList"),
+        WireField("totalViewerCount"), WireField("isGiftEnabled"), WireField("metaData"),
+    ]
+
+    static let networkInfo: [WireField] = [
+        WireField("userID"), WireField("quality"), WireField("upLoss"), WireField("downLoss"),
+        WireField("delay"),
+    ]
+
+    /// 是否启用紧凑格式，由 JS 侧通过 setBridgeWireFormat 开启
+    public static var isEnabled = false
+
+    static func pack(_ dict: [String: Any], _ schema: [WireField]) -> [Any] {
+        return schema.map { field in
+            guard let value = dict[field.key] else { return NSNull() }
+            if let nested = field.nested, let nestedDict = value as? [String: Any] {
+                return pack(nestedDict, nested)
+            }
+            return value
+        }
+    }
+
+    /// 编码为 ["c1", header..., row...]
+    static func encode(_ dicts: [[String: Any]], _ schema: [WireField], header: [Any] = []) -> String? {
+        var payload: [Any] = [tag]
+        payload.append(contentsOf: header)
+        payload.append(contentsOf: dicts.map { pack($0, schema) })
+        return JsonUtil.toJson(payload)
+    }
+
+    /// 编码 userID -> 数值 的映射为 ["c1", key, value, key, value...]
+    static func encodeMap(_ map: [String: Any]) -> String? {
+        var payload: [Any] = [tag]
+        for (key, value) in map {
+            payload.append(key)
+            payload.append(value)
+        }
+        return JsonUtil.toJson(payload)
+    }
+}
@@ -7,35 +7,42 @@ public class AudioEffectStoreObserver {
     private var cancellables = Set<AnyCancellable>()
     public static let shared = AudioEffectStoreObserver()
 
+    /// 取消 store 状态订阅，由 JS 侧订阅引用计数归零时调用
+    public func unsubscribe() {
+        cancellables.removeAll()
+    }
+
     public func audioEffectStoreChanged(
         _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
         cancellables.removeAll()
+        let callback = BridgeDeduplicator.shared.distinctCallback(
+            store: "AudioEffect", BridgeEncoder.shared.mainThreadCallback(store: "AudioEffect", callback))
 
         AudioEffectStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \AudioEffectState.audioChangerType))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "AudioEffect"))
             .sink(receiveValue: { value in
                 callback("audioChangerType", String(value.rawValue))
             }).store(in: &cancellables)
 
         AudioEffectStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \AudioEffectState.audioReverbType))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "AudioEffect"))
             .sink(receiveValue: { value in
                 callback("audioReverbType", String(value.rawValue))
             }).store(in: &cancellables)
 
         AudioEffectStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \AudioEffectState.isEarMonitorOpened))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "AudioEffect"))
             .sink(receiveValue: { value in
                 callback("isEarMonitorOpened", String(value))
             }).store(in: &cancellables)
 
         AudioEffectStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \AudioEffectState.earMonitorVolume))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "AudioEffect"))
             .sink(receiveValue: { value in
                 callback("earMonitorVolume", String(value))
             }).store(in: &cancellables)
@@ -5,36 +5,96 @@ import Foundation
 import RTCRoomEngine
 
 public class BarrageStoreObserver {
-    private var cancellables = Set<AnyCancellable>()
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private var roomCancellables: [String: Set<AnyCancellable>] = [:]
     public static let shared = BarrageStoreObserver()
 
+    // 单个直播间已同步到 JS 侧的最后一条消息序列号及列表长度，用于计算增量；只在 Barrage 编码队列上读写
+    private final class SyncProgress {
+        var lastSyncedSequence: Int?
+        var lastSyncedCount = 0
+    }
+
+    /// 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+    public func unsubscribe(_ liveID: String) {
+        roomCancellables.removeValue(forKey: liveID)
+    }
+
     public func barrageStoreChanged(
         _ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
-        cancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { roomCancellables[liveID] = cancellables }
+        let callback = BridgeDeduplicator.shared.distinctCallback(
+            store: "Barrage", liveID: liveID, BridgeEncoder.shared.mainThreadCallback(store: "Barrage", callback))
+        let progress = SyncProgress()
         BarrageStore.create(liveID: liveID)
             .state.subscribe(StatePublisherSelector(keyPath: \BarrageState.messageList))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Barrage"))
             .sink(receiveValue: { [weak self] messageList in
                 guard let self = self else { return }
-                let dict = messageList.map { self.convertBarrageToDic(barrage: $0) }
-                if let jsonList = JsonUtil.toJson(dict) {
-                    callback("messageList", jsonList)
-                }
+                self.syncMessageList(messageList, progress, callback)
             }).store(in: &cancellables)
         // TODO: 底层未实现，暂时隐藏
         // BarrageStore.create(liveID: liveID)
         //     .state.subscribe(StatePublisherSelector(keyPath: \BarrageState.allowSendMessage))
-        //     .receive(on: DispatchQueue.main)
+        //     .receive(on: BridgeEncoder.shared.queue(for: "Barrage"))
         //     .sink(receiveValue: { message in
         //         callback("allowSendMessage", String(message))
         //     }).store(in: &cancellables)
     }
 
-    private func convertBarrageToDic(barrage: Barrage) -> [String: Any] {
+    /// 只下发上次同步之后追加的消息；找不到上次同步位置时（首次订阅、store 重新同步）下发全量 reset
+    private func syncMessageList(
+        _ messageList: [Barrage], _ progress: SyncProgress,
+        _ callback: @escaping (_ name: String, _ data: String) -> Void
+    ) {
+        defer {
+            progress.lastSyncedSequence = messageList.last?.sequence
+            progress.lastSyncedCount = messageList.count
+        }
+        if let lastSequence = progress.lastSyncedSequence,
+            let lastIndex = messageList.lastIndex(where: { $0.sequence == lastSequence })
+        {
+            let appended = messageList[(lastIndex + 1)...]
+            if appended.isEmpty && messageList.count == progress.lastSyncedCount {
+                return
+            }
+            let messages = convertBarrageList(Array(appended), callback)
+            let json: String?
+            if WireSchema.isEnabled {
+                json = WireSchema.encode(messages, WireSchema.barrage, header: [messageList.count])
+            } else {
+                json = JsonUtil.toJson(["total": messageList.count, "messages": messages] as [String: Any])
+            }
+            if let json = json {
+                callback("messageListAppend", json)
+            }
+            return
+        }
+        let dict = convertBarrageList(messageList, callback)
+        let jsonList = WireSchema.isEnabled ? WireSchema.encode(dict, WireSchema.barrage) : JsonUtil.toJson(dict)
+        if let jsonList = jsonList {
+            callback("messageListReset", jsonList)
+        }
+    }
+
+    /// 开启用户资料驻留时 sender 只携带句柄，资料由 UserInternTable 通过 userProfiles 先行下发
+    private func convertBarrageList(
+        _ messages: [Barrage], _ callback: @escaping (_ name: String, _ data: String) -> Void
+    ) -> [[String: Any]] {
+        guard UserInternTable.shared.isEnabled else {
+            return messages.map { convertBarrageToDic(barrage: $0) }
+        }
+        let handles = UserInternTable.shared.intern(messages.map { $0.sender }, callback)
+        return zip(messages, handles).map { convertBarrageToDic(barrage: $0, sender: $1) }
+    }
+
+    private func convertBarrageToDic(barrage: Barrage, sender: Int? = nil) -> [String: Any] {
         var dict: [String: Any] = [
             "liveID": barrage.liveID,
-            "sender": TypeConvert.convertLiveUserInfoToDic(liveUserInfo: barrage.sender),
+            "sender": sender.map { $0 as Any }
+                ?? TypeConvert.convertLiveUserInfoToDic(liveUserInfo: barrage.sender),
             "sequence": barrage.sequence,
             "timestampInSecond": barrage.timestampInSecond,
             "messageType": convertMessageType(barrage.messageType),
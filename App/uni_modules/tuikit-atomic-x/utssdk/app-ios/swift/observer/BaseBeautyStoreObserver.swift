@@ -7,26 +7,33 @@ public class BaseBeautyStoreObserver {
     private var cancellables = Set<AnyCancellable>()
     public static let shared = BaseBeautyStoreObserver()
 
+    /// 取消 store 状态订阅，由 JS 侧订阅引用计数归零时调用
+    public func unsubscribe() {
+        cancellables.removeAll()
+    }
+
     public func beautyStoreChanged(_ callback: @escaping (_ name: String, _ data: String) -> Void) {
         cancellables.removeAll()
+        let callback = BridgeDeduplicator.shared.distinctCallback(
+            store: "BaseBeauty", BridgeEncoder.shared.mainThreadCallback(store: "BaseBeauty", callback))
 
         BaseBeautyStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \BaseBeautyState.smoothLevel))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "BaseBeauty"))
             .sink(receiveValue: { value in
                 callback("smoothLevel", String(value))
             }).store(in: &cancellables)
 
         BaseBeautyStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \BaseBeautyState.whitenessLevel))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "BaseBeauty"))
             .sink(receiveValue: { value in
                 callback("whitenessLevel", String(value))
             }).store(in: &cancellables)
 
         BaseBeautyStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \BaseBeautyState.ruddyLevel))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "BaseBeauty"))
             .sink(receiveValue: { value in
                 callback("ruddyLevel", String(value))
             }).store(in: &cancellables)
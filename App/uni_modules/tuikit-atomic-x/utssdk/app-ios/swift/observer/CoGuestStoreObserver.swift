@@ -4,18 +4,29 @@ import DCloudUTSFoundation
 import RTCRoomEngine
 
 public class CoGuestStoreObserver {
-    private var cancellables = Set<AnyCancellable>()
-    private var hostEventCancellables = Set<AnyCancellable>()
-    private var guestEventCancellables = Set<AnyCancellable>()
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private var roomCancellables: [String: Set<AnyCancellable>] = [:]
+    // 按 liveID 隔离的事件订阅，多个直播间的事件监听互不覆盖
+    private var hostEventCancellables: [String: Set<AnyCancellable>] = [:]
+    // 按 liveID 隔离的事件订阅，多个直播间的事件监听互不覆盖
+    private var guestEventCancellables: [String: Set<AnyCancellable>] = [:]
     public static let shared = CoGuestStoreObserver()
 
+    /// 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+    public func unsubscribe(_ liveID: String) {
+        roomCancellables.removeValue(forKey: liveID)
+    }
+
     public func coGuestStoreChanged(
         _ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
-        cancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { roomCancellables[liveID] = cancellables }
+        let callback = BridgeDeduplicator.shared.distinctCallback(
+            store: "CoGuest", liveID: liveID, BridgeEncoder.shared.mainThreadCallback(store: "CoGuest", callback))
         CoGuestStore.create(liveID: liveID)
             .state.subscribe(StatePublisherSelector(keyPath: \CoGuestState.connected))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "CoGuest"))
             .sink(receiveValue: { arr in
                 let dict = arr.map { TypeConvert.convertSeatUserInfoToDic(seatUserInfo: $0) }
                 if let json = JsonUtil.toJson(dict) {
@@ -31,7 +42,7 @@ public class CoGuestStoreObserver {
         for (key, kp) in arrayKeys {
             CoGuestStore.create(liveID: liveID)
                 .state.subscribe(StatePublisherSelector(keyPath: kp))
-                .receive(on: DispatchQueue.main)
+                .receive(on: BridgeEncoder.shared.queue(for: "CoGuest"))
                 .sink(receiveValue: { arr in
                     let dict = arr.map { TypeConvert.convertLiveUserInfoToDic(liveUserInfo: $0) }
                     if let json = JsonUtil.toJson(dict) {
@@ -41,10 +52,16 @@ public class CoGuestStoreObserver {
         }
     }
 
+    /// 取消指定直播间的事件订阅，由该房间最后一个事件监听被移除时调用
+    public func removeHostEvent(_ liveID: String) {
+        hostEventCancellables.removeValue(forKey: liveID)
+    }
+
     public func setupHostEvent(
         _ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
-        hostEventCancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { hostEventCancellables[liveID] = cancellables }
         CoGuestStore.create(liveID: liveID).hostEventPublisher
             .receive(on: RunLoop.main)
             .sink { [weak self] event in
@@ -86,7 +103,7 @@ public class CoGuestStoreObserver {
                         callback("onHostInvitationNoResponse", json)
                     }
                 }
-            }.store(in: &hostEventCancellables)
+            }.store(in: &cancellables)
     }
 
     private func convertNoResponseReason(_ reason: NoResponseReason) -> String {
@@ -96,10 +113,16 @@ public class CoGuestStoreObserver {
         return "TIMEOUT"
     }
 
+    /// 取消指定直播间的事件订阅，由该房间最后一个事件监听被移除时调用
+    public func removeGuestEvent(_ liveID: String) {
+        guestEventCancellables.removeValue(forKey: liveID)
+    }
+
     public func setupGuestEvent(
         _ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
-        guestEventCancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { guestEventCancellables[liveID] = cancellables }
         CoGuestStore.create(liveID: liveID).guestEventPublisher
             .receive(on: RunLoop.main)
             .sink { [weak self] event in
@@ -140,6 +163,6 @@ public class CoGuestStoreObserver {
                         callback("onKickedOffSeat", json)
                     }
                 }
-            }.store(in: &guestEventCancellables)
+            }.store(in: &cancellables)
     }
 }
@@ -4,18 +4,28 @@ import DCloudUTSFoundation
 import RTCRoomEngine
 
 public class CoHostStoreObserver {
-    private var cancellables = Set<AnyCancellable>()
-    private var coHostEventCancellables = Set<AnyCancellable>()
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private var roomCancellables: [String: Set<AnyCancellable>] = [:]
+    // 按 liveID 隔离的事件订阅，多个直播间的事件监听互不覆盖
+    private var coHostEventCancellables: [String: Set<AnyCancellable>] = [:]
     public static let shared = CoHostStoreObserver()
 
+    /// 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+    public func unsubscribe(_ liveID: String) {
+        roomCancellables.removeValue(forKey: liveID)
+    }
+
     public func coHostStoreChanged(
         _ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
-        cancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { roomCancellables[liveID] = cancellables }
+        let callback = BridgeDeduplicator.shared.distinctCallback(
+            store: "CoHost", liveID: liveID, BridgeEncoder.shared.mainThreadCallback(store: "CoHost", callback))
 
         CoHostStore.create(liveID: liveID)
             .state.subscribe(StatePublisherSelector(keyPath: \CoHostState.coHostStatus))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "CoHost"))
             .sink(receiveValue: { value in
                 var coHostStatus = "DISCONNECTED"
                 if value == .connected {
@@ -28,7 +38,7 @@ public class CoHostStoreObserver {
 
         CoHostStore.create(liveID: liveID)
             .state.subscribe(StatePublisherSelector(keyPath: \CoHostState.connected))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "CoHost"))
             .sink(receiveValue: { arr in
                 let dict = arr.map { TypeConvert.convertSeatUserInfoToDic(seatUserInfo: $0) }
                 if let json = JsonUtil.toJson(dict) {
@@ -38,7 +48,7 @@ public class CoHostStoreObserver {
         //TODO: 底层未实现，暂时删除
         // CoHostStore.create(liveID: liveID)
         //     .state.subscribe(StatePublisherSelector(keyPath: \CoHostState.candidates))
-        //     .receive(on: DispatchQueue.main)
+        //     .receive(on: BridgeEncoder.shared.queue(for: "CoHost"))
         //     .sink(receiveValue: { arr in
         //         let dict = arr.map { TypeConvert.convertSeatUserInfoToDic(seatUserInfo: $0) }
         //         if let json = JsonUtil.toJson(dict) {
@@ -48,7 +58,7 @@ public class CoHostStoreObserver {
 
         CoHostStore.create(liveID: liveID)
             .state.subscribe(StatePublisherSelector(keyPath: \CoHostState.invitees))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "CoHost"))
             .sink(receiveValue: { arr in
                 let dict = arr.map { TypeConvert.convertSeatUserInfoToDic(seatUserInfo: $0) }
                 if let json = JsonUtil.toJson(dict) {
@@ -58,7 +68,7 @@ public class CoHostStoreObserver {
 
         CoHostStore.create(liveID: liveID)
             .state.subscribe(StatePublisherSelector(keyPath: \CoHostState.applicant))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "CoHost"))
             .sink(receiveValue: { [weak self] value in
                 guard let self = self else { return }
                 guard let value = value else { return }
@@ -69,10 +79,16 @@ public class CoHostStoreObserver {
             }).store(in: &cancellables)
     }
 
+    /// 取消指定直播间的事件订阅，由该房间最后一个事件监听被移除时调用
+    public func removeCoHostEvent(_ liveID: String) {
+        coHostEventCancellables.removeValue(forKey: liveID)
+    }
+
     public func setupCoHostEvent(
         _ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
-        coHostEventCancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { coHostEventCancellables[liveID] = cancellables }
         CoHostStore.create(liveID: liveID).coHostEventPublisher
             .receive(on: RunLoop.main)
             .sink { [weak self] event in
@@ -133,6 +149,6 @@ public class CoHostStoreObserver {
                         callback("onCoHostUserLeft", json)
                     }
                 }
-            }.store(in: &coHostEventCancellables)
+            }.store(in: &cancellables)
     }
 }
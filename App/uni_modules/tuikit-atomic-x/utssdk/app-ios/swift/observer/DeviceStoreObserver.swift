@@ -7,68 +7,78 @@ public class DeviceStoreObserver {
     private var cancellables = Set<AnyCancellable>()
     public static let shared = DeviceStoreObserver()
 
+    /// 取消 store 状态订阅，由 JS 侧订阅引用计数归零时调用
+    public func unsubscribe() {
+        cancellables.removeAll()
+    }
+
     public func deviceStoreChanged(_ callback: @escaping (_ name: String, _ data: String) -> Void) {
         cancellables.removeAll()
+        let callback = BridgeDeduplicator.shared.distinctCallback(
+            store: "Device",
+            BridgeRateLimiter.shared.rateLimitedCallback(
+                store: "Device", cancellables: &cancellables,
+                BridgeEncoder.shared.mainThreadCallback(store: "Device", callback)))
 
         DeviceStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \DeviceState.microphoneStatus))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Device"))
             .sink(receiveValue: { value in
                 callback("microphoneStatus", String(value.rawValue))
             }).store(in: &cancellables)
 
         DeviceStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \DeviceState.microphoneLastError))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Device"))
             .sink(receiveValue: { value in
                 callback("microphoneLastError", String(value.rawValue))
             }).store(in: &cancellables)
 
         DeviceStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \DeviceState.captureVolume))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Device"))
             .sink(receiveValue: { value in
                 callback("captureVolume", String(value))
             }).store(in: &cancellables)
 
         DeviceStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \DeviceState.currentMicVolume))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Device"))
             .sink(receiveValue: { value in
                 callback("currentMicVolume", String(value))
             }).store(in: &cancellables)
 
         DeviceStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \DeviceState.outputVolume))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Device"))
             .sink(receiveValue: { value in
                 callback("outputVolume", String(value))
             }).store(in: &cancellables)
 
         DeviceStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \DeviceState.cameraStatus))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Device"))
             .sink(receiveValue: { value in
                 callback("cameraStatus", String(value.rawValue))
             }).store(in: &cancellables)
 
         DeviceStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \DeviceState.cameraLastError))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Device"))
             .sink(receiveValue: { value in
                 callback("cameraLastError", String(value.rawValue))
             }).store(in: &cancellables)
 
         DeviceStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \DeviceState.isFrontCamera))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Device"))
             .sink(receiveValue: { value in
                 callback("isFrontCamera", String(value))
             }).store(in: &cancellables)
 
         DeviceStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \DeviceState.localMirrorType))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Device"))
             .sink(receiveValue: { [weak self] value in
                 guard let self = self else { return }
                 if let json = JsonUtil.toJson(convertLocalMirrorType(value)) {
@@ -78,7 +88,7 @@ public class DeviceStoreObserver {
 
         DeviceStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \DeviceState.localVideoQuality))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Device"))
             .sink(receiveValue: { [weak self] value in
                 guard let self = self else { return }
                 callback("localVideoQuality", convertVideoQuality(value))
@@ -86,24 +96,29 @@ public class DeviceStoreObserver {
 
         DeviceStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \DeviceState.currentAudioRoute))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Device"))
             .sink(receiveValue: { value in
                 callback("currentAudioRoute", String(value.rawValue))
             }).store(in: &cancellables)
 
         DeviceStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \DeviceState.screenStatus))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Device"))
             .sink(receiveValue: { value in
                 callback("screenStatus", String(value.rawValue))
             }).store(in: &cancellables)
 
         DeviceStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \DeviceState.networkInfo))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Device"))
             .sink(receiveValue: { [weak self] value in
                 guard let self = self else { return }
-                if let json = JsonUtil.toJson(convertNetworkInfo(value)) {
+                let dict = convertNetworkInfo(value)
+                let json =
+                    WireSchema.isEnabled
+                    ? JsonUtil.toJson([WireSchema.tag, WireSchema.pack(dict, WireSchema.networkInfo)] as [Any])
+                    : JsonUtil.toJson(dict)
+                if let json = json {
                     callback("networkInfo", json)
                 }
             }).store(in: &cancellables)
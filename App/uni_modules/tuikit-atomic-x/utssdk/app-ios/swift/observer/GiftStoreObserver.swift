@@ -4,17 +4,27 @@ import DCloudUTSFoundation
 import RTCRoomEngine
 
 public class GiftStoreObserver {
-    private var cancellables = Set<AnyCancellable>()
-    private var giftEventCancellables = Set<AnyCancellable>()
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private var roomCancellables: [String: Set<AnyCancellable>] = [:]
+    // 按 liveID 隔离的事件订阅，多个直播间的事件监听互不覆盖
+    private var giftEventCancellables: [String: Set<AnyCancellable>] = [:]
     public static let shared = GiftStoreObserver()
 
+    /// 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+    public func unsubscribe(_ liveID: String) {
+        roomCancellables.removeValue(forKey: liveID)
+    }
+
     public func giftStoreChanged(
         _ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
-        cancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { roomCancellables[liveID] = cancellables }
+        let callback = BridgeDeduplicator.shared.distinctCallback(
+            store: "Gift", liveID: liveID, BridgeEncoder.shared.mainThreadCallback(store: "Gift", callback))
         GiftStore.create(liveID: liveID)
             .state.subscribe(StatePublisherSelector(keyPath: \GiftState.usableGifts))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Gift"))
             .sink(receiveValue: { [weak self] usableGifts in
                 guard let self = self else { return }
                 let dict = usableGifts.map { self.convertGiftCategoryToDic(giftCategory: $0) }
@@ -50,10 +60,16 @@ public class GiftStoreObserver {
         ]
     }
 
+    /// 取消指定直播间的事件订阅，由该房间最后一个事件监听被移除时调用
+    public func removeGiftEvent(_ liveID: String) {
+        giftEventCancellables.removeValue(forKey: liveID)
+    }
+
     public func setupGiftEvent(
         _ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
-        giftEventCancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { giftEventCancellables[liveID] = cancellables }
         GiftStore.create(liveID: liveID).giftEventPublisher
             .receive(on: RunLoop.main)
             .sink { [weak self] event in
@@ -69,6 +85,6 @@ public class GiftStoreObserver {
                         callback("onReceiveGift", json)
                     }
                 }
-            }.store(in: &giftEventCancellables)
+            }.store(in: &cancellables)
     }
 }
@@ -4,24 +4,40 @@ import DCloudUTSFoundation
 import RTCRoomEngine
 
 public class LikeStoreObserver {
-    private var cancellables = Set<AnyCancellable>()
-    private var likeEventCancellables = Set<AnyCancellable>()
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private var roomCancellables: [String: Set<AnyCancellable>] = [:]
+    // 按 liveID 隔离的事件订阅，多个直播间的事件监听互不覆盖
+    private var likeEventCancellables: [String: Set<AnyCancellable>] = [:]
     public static let shared = LikeStoreObserver()
 
+    /// 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+    public func unsubscribe(_ liveID: String) {
+        roomCancellables.removeValue(forKey: liveID)
+    }
+
     public func likeStoreChanged(
         _ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
-        cancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { roomCancellables[liveID] = cancellables }
+        let callback = BridgeDeduplicator.shared.distinctCallback(
+            store: "Like", liveID: liveID, BridgeEncoder.shared.mainThreadCallback(store: "Like", callback))
         LikeStore.create(liveID: liveID)
             .state.subscribe(StatePublisherSelector(keyPath: \LikeState.totalLikeCount))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Like"))
             .sink(receiveValue: { totalLikeCount in
                 callback("totalLikeCount", String(totalLikeCount))
             }).store(in: &cancellables)
     }
     
+    /// 取消指定直播间的事件订阅，由该房间最后一个事件监听被移除时调用
+    public func removeLikeEvent(_ liveID: String) {
+        likeEventCancellables.removeValue(forKey: liveID)
+    }
+
     public func setupLikeEvent(_ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void) {
-        likeEventCancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { likeEventCancellables[liveID] = cancellables }
         LikeStore.create(liveID: liveID).likeEventPublisher
             .receive(on: RunLoop.main)
             .sink { [weak self] event in
@@ -36,6 +52,6 @@ public class LikeStoreObserver {
                         callback("onReceiveLikesMessage", json)
                     }
                 }
-            }.store(in: &likeEventCancellables)
+            }.store(in: &cancellables)
     }
 }
@@ -4,40 +4,173 @@ import DCloudUTSFoundation
 import RTCRoomEngine
 
 public class LiveAudienceStoreObserver {
-    private var cancellables = Set<AnyCancellable>()
-    private var audienceCancellables = Set<AnyCancellable>()
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private var roomCancellables: [String: Set<AnyCancellable>] = [:]
+    // 按 liveID 隔离的事件订阅，多个直播间的事件监听互不覆盖
+    private var audienceCancellables: [String: Set<AnyCancellable>] = [:]
     public static let shared = LiveAudienceStoreObserver()
 
+    // JS 侧观众名单窗口大小，全量及单次新增下发的观众数量不超过该值；只在 LiveAudience 编码队列上读写
+    private var audienceWindowSize = 100
+    // 单个直播间已下发到 JS 名单窗口的观众（sentIDs 为下发顺序，profiles 为下发时的资料），
+    // 用于计算 joined/left/updated 增量；只在 LiveAudience 编码队列上读写
+    private final class AudienceSnapshot {
+        var sentIDs: [String]?
+        var profiles: [String: [String]] = [:]
+    }
+
+    private func profileOf(_ user: LiveUserInfo) -> [String] {
+        return [user.userName ?? "", user.avatarURL ?? ""]
+    }
+
+    /// 设置观众名单窗口大小，可在任意线程调用：写入切到 LiveAudience 编码队列，与下发时的读取串行
+    public func setAudienceWindowSize(_ size: Int) {
+        BridgeEncoder.shared.queue(for: "LiveAudience").async { [weak self] in
+            self?.audienceWindowSize = size
+        }
+    }
+
+    /// 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+    public func unsubscribe(_ liveID: String) {
+        roomCancellables.removeValue(forKey: liveID)
+    }
+
     public func liveAudienceStoreChanged(
         _ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
-        cancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { roomCancellables[liveID] = cancellables }
+        let callback = BridgeDeduplicator.shared.distinctCallback(
+            store: "LiveAudience", liveID: liveID,
+            BridgeEncoder.shared.mainThreadCallback(store: "LiveAudience", callback))
+        let snapshot = AudienceSnapshot()
 
         LiveAudienceStore.create(liveID: liveID)
             .state.subscribe(StatePublisherSelector(keyPath: \LiveAudienceState.audienceList))
-            .receive(on: DispatchQueue.main)
-            .sink(receiveValue: { audienceList in
-                let dict = audienceList.map {
-                    TypeConvert.convertLiveUserInfoToDic(liveUserInfo: $0)
-                }
-                if let jsonList = JsonUtil.toJson(dict) {
-                    callback("audienceList", jsonList)
-                }
+            .receive(on: BridgeEncoder.shared.queue(for: "LiveAudience"))
+            .sink(receiveValue: { [weak self] audienceList in
+                guard let self = self else { return }
+                self.syncAudienceList(audienceList, snapshot, callback)
             })
             .store(in: &cancellables)
 
         LiveAudienceStore.create(liveID: liveID)
             .state.subscribe(StatePublisherSelector(keyPath: \LiveAudienceState.audienceCount))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "LiveAudience"))
             .sink(receiveValue: { count in
                 callback("audienceCount", String(count))
             }).store(in: &cancellables)
     }
 
+    /// 首次同步下发窗口内的全量名单，之后只下发相对已下发窗口的增量：离开的 userID（left）、资料变化的观众（updated），
+    /// 以及补满窗口的观众（joined）。窗口已满时新进入的观众暂不下发，窗口内有人离开后按名单顺序补入
+    private func syncAudienceList(
+        _ audienceList: [LiveUserInfo], _ snapshot: AudienceSnapshot,
+        _ callback: @escaping (_ name: String, _ data: String) -> Void
+    ) {
+        guard var sentIDs = snapshot.sentIDs else {
+            let window = Array(audienceList.prefix(audienceWindowSize))
+            snapshot.sentIDs = window.map { $0.userID }
+            snapshot.profiles = Dictionary(window.map { ($0.userID, profileOf($0)) }, uniquingKeysWith: { first, _ in first })
+            let jsonList: String?
+            if UserInternTable.shared.isEnabled {
+                let handles = UserInternTable.shared.intern(window, callback)
+                let rows: [Any] = handles
+                jsonList = JsonUtil.toJson(WireSchema.isEnabled ? [WireSchema.tag as Any] + rows : rows)
+            } else {
+                let dict = window.map { TypeConvert.convertLiveUserInfoToDic(liveUserInfo: $0) }
+                jsonList =
+                    WireSchema.isEnabled ? WireSchema.encode(dict, WireSchema.liveUserInfo) : JsonUtil.toJson(dict)
+            }
+            if let jsonList = jsonList {
+                callback("audienceList", jsonList)
+            }
+            return
+        }
+        let current = Dictionary(audienceList.map { ($0.userID, $0) }, uniquingKeysWith: { first, _ in first })
+        let left = sentIDs.filter { current[$0] == nil }
+        sentIDs.removeAll { current[$0] == nil }
+        // 窗口缩小时 JS 侧从尾部裁剪，这里同步移出
+        if sentIDs.count > audienceWindowSize {
+            sentIDs.removeLast(sentIDs.count - audienceWindowSize)
+        }
+        var profiles: [String: [String]] = [:]
+        var updatedUsers: [LiveUserInfo] = []
+        for userID in sentIDs {
+            guard let user = current[userID] else { continue }
+            let profile = profileOf(user)
+            if snapshot.profiles[userID] != profile {
+                updatedUsers.append(user)
+            }
+            profiles[userID] = profile
+        }
+        var joinedUsers: [LiveUserInfo] = []
+        for user in audienceList where sentIDs.count < audienceWindowSize && profiles[user.userID] == nil {
+            sentIDs.append(user.userID)
+            profiles[user.userID] = profileOf(user)
+            joinedUsers.append(user)
+        }
+        snapshot.sentIDs = sentIDs
+        snapshot.profiles = profiles
+        if joinedUsers.isEmpty && left.isEmpty && updatedUsers.isEmpty {
+            return
+        }
+        let json: String?
+        if UserInternTable.shared.isEnabled {
+            let handles = UserInternTable.shared.intern(joinedUsers + updatedUsers, callback)
+            let joined = Array(handles.prefix(joinedUsers.count))
+            let updated = Array(handles.suffix(updatedUsers.count))
+            json =
+                WireSchema.isEnabled
+                ? JsonUtil.toJson([WireSchema.tag, joined, left, updated] as [Any])
+                : JsonUtil.toJson(["joined": joined, "left": left, "updated": updated] as [String: Any])
+        } else {
+            let joined = joinedUsers.map { TypeConvert.convertLiveUserInfoToDic(liveUserInfo: $0) }
+            let updated = updatedUsers.map { TypeConvert.convertLiveUserInfoToDic(liveUserInfo: $0) }
+            json =
+                WireSchema.isEnabled
+                ? JsonUtil.toJson([
+                    WireSchema.tag,
+                    joined.map { WireSchema.pack($0, WireSchema.liveUserInfo) },
+                    left,
+                    updated.map { WireSchema.pack($0, WireSchema.liveUserInfo) },
+                ] as [Any])
+                : JsonUtil.toJson(["joined": joined, "left": left, "updated": updated] as [String: Any])
+        }
+        if let json = json {
+            callback("audienceListDelta", json)
+        }
+    }
+
+    /// 通过 TUIRoomEngine 分页拉取观众名单，用于加载窗口之外的观众
+    public func fetchAudienceListPage(
+        _ nextSequence: Int, _ onSuccess: @escaping (_ data: String) -> Void,
+        _ onError: @escaping (_ code: Int, _ message: String) -> Void
+    ) {
+        TUIRoomEngine.sharedInstance().getUserList(nextSequence: nextSequence) { userInfoList, nextSequence in
+            let list: [[String: String]] = userInfoList.map {
+                ["userID": $0.userId, "userName": $0.userName, "avatarURL": $0.avatarUrl]
+            }
+            let dict: [String: Any] = [
+                "audienceList": list,
+                "nextSequence": nextSequence,
+            ]
+            onSuccess(JsonUtil.toJson(dict) ?? "")
+        } onError: { code, message in
+            onError(code.rawValue, message)
+        }
+    }
+
+    /// 取消指定直播间的事件订阅，由该房间最后一个事件监听被移除时调用
+    public func removeAudienceEvent(_ liveID: String) {
+        audienceCancellables.removeValue(forKey: liveID)
+    }
+
     public func setupAudienceEvent(
         _ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
-        audienceCancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { audienceCancellables[liveID] = cancellables }
         LiveAudienceStore.create(liveID: liveID).liveAudienceEventPublisher
             .receive(on: RunLoop.main)
             .sink { [weak self] event in
@@ -59,6 +192,6 @@ public class LiveAudienceStoreObserver {
                     }
                     break
                 }
-            }.store(in: &audienceCancellables)
+            }.store(in: &cancellables)
     }
 }
@@ -9,23 +9,41 @@ public class LiveListStoreObserver {
     private var liveListEventCancellables = Set<AnyCancellable>()
     public static let shared = LiveListStoreObserver()
 
+    // 以下状态只在 LiveList 编码队列上访问
+    private var liveInfoFields: [String]?
+    private var includeFullList = true
+    private var lastLiveList: [LiveInfo] = []
+    private var liveListCallback: ((_ name: String, _ data: String) -> Void)?
+
+    /// 取消 store 状态订阅，由 JS 侧订阅引用计数归零时调用
+    public func unsubscribe() {
+        cancellables.removeAll()
+        BridgeEncoder.shared.queue(for: "LiveList").async { [weak self] in
+            self?.liveListCallback = nil
+            self?.lastLiveList = []
+        }
+    }
+
     public func liveStoreChanged(_ callback: @escaping (_ name: String, _ data: String) -> Void) {
         cancellables.removeAll()
+        let callback = BridgeDeduplicator.shared.distinctCallback(
+            store: "LiveList", BridgeEncoder.shared.mainThreadCallback(store: "LiveList", callback))
+        BridgeEncoder.shared.queue(for: "LiveList").async { [weak self] in
+            self?.liveListCallback = callback
+        }
 
         LiveListStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \LiveListState.liveList))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "LiveList"))
             .sink(receiveValue: { [weak self] liveList in
                 guard let self = self else { return }
-                let dict = liveList.map { TypeConvert.convertLiveInfoToDic(liveInfo: $0) }
-                if let jsonList = JsonUtil.toJson(dict) {
-                    callback("liveList", jsonList)
-                }
+                self.lastLiveList = liveList
+                self.emitLiveList(callback)
             }).store(in: &cancellables)
 
         LiveListStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \LiveListState.liveListCursor))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "LiveList"))
             .sink(receiveValue: { liveListCursor in
                 if let json = JsonUtil.toJson(liveListCursor) {
                     callback("liveListCursor", json)
@@ -34,7 +52,7 @@ public class LiveListStoreObserver {
 
         LiveListStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \LiveListState.currentLive))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "LiveList"))
             .sink(receiveValue: { [weak self] liveInfo in
                 guard let self = self else { return }
                 let dict = TypeConvert.convertLiveInfoToDic(liveInfo: liveInfo)
@@ -44,6 +62,43 @@ public class LiveListStoreObserver {
             }).store(in: &cancellables)
     }
 
+    /// 设置 liveList 的字段投影：fields 非 nil 时按投影下发 liveListProjected，includeFullList 为 false 时不再下发完整的 liveList。
+    /// 变更后立即按新设置重新下发当前列表
+    public func setLiveInfoProjection(_ fields: [String]?, includeFullList: Bool) {
+        BridgeEncoder.shared.queue(for: "LiveList").async { [weak self] in
+            guard let self = self else { return }
+            self.liveInfoFields = fields
+            self.includeFullList = includeFullList || fields == nil
+            if let callback = self.liveListCallback {
+                self.emitLiveList(callback)
+            }
+        }
+    }
+
+    private func emitLiveList(_ callback: @escaping (_ name: String, _ data: String) -> Void) {
+        if includeFullList {
+            emitLiveList(name: "liveList", fields: nil, callback)
+        }
+        if let fields = liveInfoFields {
+            emitLiveList(name: "liveListProjected", fields: fields, callback)
+        }
+    }
+
+    private func emitLiveList(name: String, fields: [String]?,
+                              _ callback: @escaping (_ name: String, _ data: String) -> Void) {
+        let dict = lastLiveList.map { TypeConvert.convertLiveInfoToDic(liveInfo: $0, fields: fields) }
+        let jsonList =
+            WireSchema.isEnabled ? WireSchema.encode(dict, WireSchema.liveInfo) : JsonUtil.toJson(dict)
+        if let jsonList = jsonList {
+            callback(name, jsonList)
+        }
+    }
+
+    /// 取消直播列表事件订阅，由最后一个事件监听被移除时调用
+    public func removeLiveListEvent() {
+        liveListEventCancellables.removeAll()
+    }
+
     public func setupLiveListEvent(_ callback: @escaping (_ name: String, _ data: String) -> Void) {
         liveListEventCancellables.removeAll()
         LiveListStore.shared.liveListEventPublisher
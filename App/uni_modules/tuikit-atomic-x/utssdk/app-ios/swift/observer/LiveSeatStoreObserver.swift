@@ -5,29 +5,58 @@ import Foundation
 import RTCRoomEngine
 
 public class LiveSeatStoreObserver {
-    private var cancellables = Set<AnyCancellable>()
-    private var liveSeatEventCancellables = Set<AnyCancellable>()
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private var roomCancellables: [String: Set<AnyCancellable>] = [:]
+    // 按 liveID 隔离的事件订阅，多个直播间的事件监听互不覆盖
+    private var liveSeatEventCancellables: [String: Set<AnyCancellable>] = [:]
     public static let shared = LiveSeatStoreObserver()
 
+    // 单个直播间上一次下发给 JS 侧的座位快照，用于计算按 index 的增量补丁；只在 LiveSeat 编码队列上读写
+    private final class SeatSnapshot {
+        var seatList: [[String: Any]] = []
+    }
+
+    /// 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+    public func unsubscribe(_ liveID: String) {
+        roomCancellables.removeValue(forKey: liveID)
+    }
+
     public func liveSeatStoreChanged(
         _ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
-        cancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { roomCancellables[liveID] = cancellables }
+        let callback = BridgeDeduplicator.shared.distinctCallback(
+            store: "LiveSeat", liveID: liveID,
+            BridgeRateLimiter.shared.rateLimitedCallback(
+                store: "LiveSeat", cancellables: &cancellables,
+                BridgeEncoder.shared.mainThreadCallback(store: "LiveSeat", callback)))
+        let snapshot = SeatSnapshot()
 
         LiveSeatStore.create(liveID: liveID)
             .state.subscribe(StatePublisherSelector(keyPath: \LiveSeatState.seatList))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "LiveSeat"))
             .sink(receiveValue: { [weak self] seatList in
                 guard let self = self else { return }
                 let dictArray = seatList.map { self.convertSeatInfoToDic(seatInfo: $0) }
-                if let jsonList = JsonUtil.toJson(dictArray) {
-                    callback("seatList", jsonList)
+                defer { snapshot.seatList = dictArray }
+                guard let patches = self.diffSeatList(old: snapshot.seatList, new: dictArray) else {
+                    let jsonList =
+                        WireSchema.isEnabled
+                        ? WireSchema.encode(dictArray, WireSchema.seatInfo) : JsonUtil.toJson(dictArray)
+                    if let jsonList = jsonList {
+                        callback("seatList", jsonList)
+                    }
+                    return
+                }
+                if !patches.isEmpty, let jsonPatches = JsonUtil.toJson(patches) {
+                    callback("seatListPatch", jsonPatches)
                 }
             }).store(in: &cancellables)
 
         LiveSeatStore.create(liveID: liveID)
             .state.subscribe(StatePublisherSelector(keyPath: \LiveSeatState.canvas))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "LiveSeat"))
             .sink(receiveValue: { [weak self] canvas in
                 guard let self = self else { return }
                 let dict = self.convertCanvasToDic(canvas: canvas)
@@ -38,14 +67,56 @@ public class LiveSeatStoreObserver {
 
         LiveSeatStore.create(liveID: liveID)
             .state.subscribe(StatePublisherSelector(keyPath: \LiveSeatState.speakingUsers))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "LiveSeat"))
             .sink(receiveValue: { speakingUsers in
-                if let jsonUsers = JsonUtil.toJson(speakingUsers) {
+                let jsonUsers =
+                    WireSchema.isEnabled ? WireSchema.encodeMap(speakingUsers) : JsonUtil.toJson(speakingUsers)
+                if let jsonUsers = jsonUsers {
                     callback("speakingUsers", jsonUsers)
                 }
             }).store(in: &cancellables)
     }
 
+    /// 按 index 比较新旧座位列表，返回仅包含变化字段的补丁；座位数量或顺序变化时返回 nil，需要下发全量
+    private func diffSeatList(old: [[String: Any]], new: [[String: Any]]) -> [[String: Any]]? {
+        guard !old.isEmpty, old.count == new.count else { return nil }
+        var patches: [[String: Any]] = []
+        for (oldSeat, newSeat) in zip(old, new) {
+            guard let index = newSeat["index"] as? Int, (oldSeat["index"] as? Int) == index else {
+                return nil
+            }
+            var patch = diffDic(old: oldSeat, new: newSeat)
+            if !patch.isEmpty {
+                patch["index"] = index
+                patches.append(patch)
+            }
+        }
+        return patches
+    }
+
+    private func diffDic(old: [String: Any], new: [String: Any]) -> [String: Any] {
+        var changed: [String: Any] = [:]
+        for (key, value) in new {
+            guard let oldValue = old[key] else {
+                changed[key] = value
+                continue
+            }
+            if let newDic = value as? [String: Any], let oldDic = oldValue as? [String: Any] {
+                let nested = diffDic(old: oldDic, new: newDic)
+                if !nested.isEmpty {
+                    changed[key] = nested
+                }
+            } else if !(oldValue as AnyObject).isEqual(value) {
+                changed[key] = value
+            }
+        }
+        // 旧快照中存在而新快照中缺失的字段显式置空，JS 侧合并补丁时据此清除该字段
+        for key in old.keys where new[key] == nil {
+            changed[key] = NSNull()
+        }
+        return changed
+    }
+
     private func convertSeatInfoToDic(seatInfo: SeatInfo) -> [String: Any] {
         var dict: [String: Any] = [
             "index": seatInfo.index,
@@ -74,10 +145,16 @@ public class LiveSeatStoreObserver {
         ]
     }
 
+    /// 取消指定直播间的事件订阅，由该房间最后一个事件监听被移除时调用
+    public func removeLiveSeatEvent(_ liveID: String) {
+        liveSeatEventCancellables.removeValue(forKey: liveID)
+    }
+
     public func setupLiveSeatEvent(
         _ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
-        liveSeatEventCancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { liveSeatEventCancellables[liveID] = cancellables }
         LiveSeatStore.create(liveID: liveID).liveSeatEventPublisher
             .receive(on: RunLoop.main)
             .sink { [weak self] event in
@@ -92,7 +169,7 @@ public class LiveSeatStoreObserver {
                 case .onLocalMicrophoneClosedByAdmin:
                     callback("onLocalMicrophoneClosedByAdmin", "")
                 }
-            }.store(in: &liveSeatEventCancellables)
+            }.store(in: &cancellables)
     }
 
     private func convertDeviceControlPolicy(_ reason: DeviceControlPolicy) -> String {
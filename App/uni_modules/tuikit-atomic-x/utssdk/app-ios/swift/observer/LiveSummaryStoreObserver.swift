@@ -4,13 +4,20 @@ import DCloudUTSFoundation
 import RTCRoomEngine
 
 public class LiveSummaryStoreObserver {
-    private var cancellables = Set<AnyCancellable>()
+    // 按 liveID 隔离的 store 订阅，当前房间、连线房间与预加载房间可同时观察
+    private var roomCancellables: [String: Set<AnyCancellable>] = [:]
     public static let shared = LiveSummaryStoreObserver()
 
+    /// 取消指定直播间的 store 状态订阅，由 JS 侧该房间订阅引用计数归零时调用
+    public func unsubscribe(_ liveID: String) {
+        roomCancellables.removeValue(forKey: liveID)
+    }
+
     public func liveSummaryStoreChanged(
         _ liveID: String, _ callback: @escaping (_ name: String, _ data: String) -> Void
     ) {
-        cancellables.removeAll()
+        var cancellables = Set<AnyCancellable>()
+        defer { roomCancellables[liveID] = cancellables }
 
         // TODO: iOS 底层 State不是 public ，访问不到，待修改
         // LiveSummaryStore.create(liveID: liveID)
@@ -7,12 +7,19 @@ public class LoginStoreObserver {
     private var cancellables = Set<AnyCancellable>()
     public static let shared = LoginStoreObserver()
 
+    /// 取消 store 状态订阅，由 JS 侧订阅引用计数归零时调用
+    public func unsubscribe() {
+        cancellables.removeAll()
+    }
+
     public func loginStoreChanged(_ callback: @escaping (_ name: String, _ data: String) -> Void) {
         cancellables.removeAll()
+        let callback = BridgeDeduplicator.shared.distinctCallback(
+            store: "Login", BridgeEncoder.shared.mainThreadCallback(store: "Login", callback))
 
         LoginStore.shared
             .state.subscribe(StatePublisherSelector(keyPath: \LoginState.loginUserInfo))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Login"))
             .sink(receiveValue: { [weak self] userInfo in
                 guard let self = self else { return }
                 guard let userInfo = userInfo else { return }
@@ -24,7 +31,7 @@ public class LoginStoreObserver {
             }).store(in: &cancellables)
 
         LoginStore.shared.state.subscribe(StatePublisherSelector(keyPath: \LoginState.loginStatus))
-            .receive(on: DispatchQueue.main)
+            .receive(on: BridgeEncoder.shared.queue(for: "Login"))
             .sink(receiveValue: { value in
                 var loginStatus = "UNLOGIN"
                 if value == .logined {
@@ -47,28 +47,45 @@ struct TypeConvert {
         }
     }
 
+    /// 完整转换 LiveInfo，字段取自 liveInfoFieldConverters，与按字段投影的转换共用一份字段表
     static func convertLiveInfoToDic(liveInfo: LiveInfo) -> [String: Any] {
-        var dict: [String: Any] = [
-            "liveID": liveInfo.liveID,
-            "liveName": liveInfo.liveName,
-            "notice": liveInfo.notice,
-            "isMessageDisable": liveInfo.isMessageDisable,
-            "isPublicVisible": liveInfo.isPublicVisible,
-            "isSeatEnabled": liveInfo.isSeatEnabled,
-            "keepOwnerOnSeat": liveInfo.keepOwnerOnSeat,
-            "maxSeatCount": liveInfo.maxSeatCount,
-            "seatMode": TypeConvert.convertTakeSeatMode(liveInfo.seatMode),
-            "seatLayoutTemplateID": liveInfo.seatLayoutTemplateID,
-            "coverURL": liveInfo.coverURL,
-            "backgroundURL": liveInfo.backgroundURL,
-            "activityStatus": liveInfo.activityStatus,
-            "liveOwner": TypeConvert.convertLiveUserInfoToDic(liveUserInfo: liveInfo.liveOwner),
-            "createTime" : liveInfo.createTime,
-            "categoryList": liveInfo.categoryList,
-            "totalViewerCount": liveInfo.totalViewerCount,
-            "isGiftEnabled": liveInfo.isGiftEnabled,
-            "metaData": liveInfo.metaData,
-        ]
+        return liveInfoFieldConverters.mapValues { $0(liveInfo) }
+    }
+
+    /// LiveInfo 各字段的转换，按字段投影时只转换订阅方需要的字段
+    static let liveInfoFieldConverters: [String: (LiveInfo) -> Any] = [
+        "liveID": { $0.liveID },
+        "liveName": { $0.liveName },
+        "notice": { $0.notice },
+        "isMessageDisable": { $0.isMessageDisable },
+        "isPublicVisible": { $0.isPublicVisible },
+        "isSeatEnabled": { $0.isSeatEnabled },
+        "keepOwnerOnSeat": { $0.keepOwnerOnSeat },
+        "maxSeatCount": { $0.maxSeatCount },
+        "seatMode": { TypeConvert.convertTakeSeatMode($0.seatMode) },
+        "seatLayoutTemplateID": { $0.seatLayoutTemplateID },
+        "coverURL": { $0.coverURL },
+        "backgroundURL": { $0.backgroundURL },
+        "activityStatus": { $0.activityStatus },
+        "liveOwner": { TypeConvert.convertLiveUserInfoToDic(liveUserInfo: $0.liveOwner) },
+        "createTime": { $0.createTime },
+        "categoryList": { $0.categoryList },
+        "totalViewerCount": { $0.totalViewerCount },
+        "isGiftEnabled": { $0.isGiftEnabled },
+        "metaData": { $0.metaData },
+    ]
+
+    /// 按字段投影转换 LiveInfo，fields 为 nil 时输出全部字段
+    static func convertLiveInfoToDic(liveInfo: LiveInfo, fields: [String]?) -> [String: Any] {
+        guard let fields = fields else {
+            return convertLiveInfoToDic(liveInfo: liveInfo)
+        }
+        var dict: [String: Any] = [:]
+        for field in fields {
+            if let converter = liveInfoFieldConverters[field] {
+                dict[field] = converter(liveInfo)
+            }
+        }
         return dict
     }
 